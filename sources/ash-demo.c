@@ -1,17 +1,32 @@
 /// HEADERS
 
+# define _GNU_SOURCE
+
 # include <stdbool.h>
 # include <stdlib.h>
 # include <stdio.h>
+# include <stdatomic.h>
+# include <stdarg.h>
+# include <stdint.h>
+# include <pthread.h>
 
 # define DS_API
 
 enum ds_event_type {
   DS_EVENT_TYPE_CUSTOM,
+  DS_EVENT_TYPE_PROCESS,
 
   DS_NUM_EVENT_TYPES
 };
 
+/// placement of the pools, combined with `|`; huge pages come from the
+/// reserved hugetlbfs pool when possible, from transparent ones otherwise
+enum ds_memory_flags {
+  DS_MEMORY_DEFAULT             = 0x0,
+  DS_MEMORY_HUGE_PAGES          = 0x1,
+  DS_MEMORY_LOCAL_NODE          = 0x2,
+};
+
 struct ds_event {
   struct ds_event *             next;
   unsigned int                  time;
@@ -19,6 +34,21 @@ struct ds_event {
   void *                        data;
 };
 
+enum ds_event_format {
+  DS_EVENT_FORMAT_TEXT,
+  DS_EVENT_FORMAT_CSV,
+  DS_EVENT_FORMAT_BINARY,
+
+  DS_NUM_EVENT_FORMATS
+};
+
+/// on-disk layout of DS_EVENT_FORMAT_BINARY, in host byte order
+struct ds_event_record {
+  uint32_t                      time;
+  uint32_t                      type;
+  uint64_t                      data;
+};
+
 DS_API bool ds_event_initialize (
   struct ds_event *             self,
   unsigned int                  time,
@@ -39,15 +69,57 @@ DS_API bool ds_event_display (
   FILE *                        file
 );
 
+/// behaves like snprintf(): returns the size the record needs, and writes it
+/// only if it fits into `size` bytes (with a terminator for text formats)
+DS_API int ds_event_serialize (
+  struct ds_event *             self,
+  enum ds_event_format          format,
+  char *                        buffer,
+  size_t                        size
+);
+
+# define DS_MAGAZINE_SIZE              64U
+
+/// stack of free events, only ever exchanged as a whole with the depot of a
+/// partitioned pool
+struct ds_event_magazine {
+  struct ds_event_magazine *    next;
+  unsigned int                  num_events;
+  struct ds_event *             events [ DS_MAGAZINE_SIZE ];
+};
+
+/// per-thread front end of a partitioned pool: the owner allocates from and
+/// frees into its two magazines without synchronization, and only locks the
+/// depot of the pool to trade an empty magazine for a full one, or the other
+/// way around, once both are empty or full; events freed on another thread
+/// than the one that acquired them flow back through the depot
+struct ds_event_cache {
+  _Alignas(64) struct ds_event_pool * pool;
+  struct ds_event_magazine *    loaded;
+  struct ds_event_magazine *    previous;
+  unsigned long long            num_exchanges;
+  _Atomic bool                  is_attached;
+};
+
 struct ds_event_pool {
   struct ds_event *             events;
   unsigned int                  max_events;
   struct ds_event *             free_event;
+  struct ds_event_cache *       caches;
+  unsigned int                  num_caches;
+  struct ds_event_magazine *    magazines;
+  unsigned int                  num_magazines;
+  struct ds_event_magazine *    full_magazine;
+  struct ds_event_magazine *    empty_magazine;
+  struct ds_event_magazine *    partial_magazine;
+  pthread_mutex_t               lock;
+  enum ds_memory_flags          flags;
 };
 
 DS_API bool ds_event_pool_initialize (
   struct ds_event_pool *        self,
-  unsigned int                  max_events
+  unsigned int                  max_events,
+  enum ds_memory_flags          flags
 );
 
 DS_API void ds_event_pool_deinitialize (
@@ -66,6 +138,37 @@ DS_API void ds_event_pool_release (
   struct ds_event *             event
 );
 
+/// moves the free events of the pool into the magazines of a depot, for up to
+/// `num_caches` threads to attach; the thread owning the pool, such as the one
+/// of the simulator, keeps acquiring and releasing with the pool functions,
+/// which then go through a cache of their own
+DS_API bool ds_event_pool_partition (
+  struct ds_event_pool *        self,
+  unsigned int                  num_caches
+);
+
+DS_API struct ds_event_cache * ds_event_pool_attach (
+  struct ds_event_pool *        self
+);
+
+/// gives the events of the cache back to the depot
+DS_API void ds_event_pool_detach (
+  struct ds_event_cache *       cache
+);
+
+DS_API struct ds_event * ds_event_cache_acquire (
+  struct ds_event_cache *       self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+);
+
+/// `event` may have been acquired through any cache of the pool
+DS_API void ds_event_cache_release (
+  struct ds_event_cache *       self,
+  struct ds_event *             event
+);
+
 struct ds_event_list {
   struct ds_event *             head;
   struct ds_event *             tail;
@@ -84,6 +187,11 @@ DS_API void ds_event_list_insert (
   struct ds_event *             event
 );
 
+DS_API void ds_event_list_insert_front (
+  struct ds_event_list *        self,
+  struct ds_event *             event
+);
+
 DS_API struct ds_event * ds_event_list_remove (
   struct ds_event_list *        self
 );
@@ -94,13 +202,15 @@ DS_API bool ds_event_list_is_empty (
 
 struct ds_event_bin {
   struct ds_event_bin *         next;
-  struct ds_event_list          events;
+  struct ds_event_list          events [ DS_NUM_EVENT_TYPES ];
   unsigned int                  time;
+  bool                          is_grouped;
 };
 
 DS_API bool ds_event_bin_initialize (
   struct ds_event_bin *         self,
-  struct ds_event *             event
+  struct ds_event *             event,
+  bool                          is_grouped
 );
 
 DS_API void ds_event_bin_deinitialize (
@@ -112,23 +222,58 @@ DS_API void ds_event_bin_insert (
   struct ds_event *             event
 );
 
+DS_API void ds_event_bin_insert_front (
+  struct ds_event_bin *         self,
+  struct ds_event *             event
+);
+
 DS_API struct ds_event * ds_event_bin_remove (
   struct ds_event_bin *         self
 );
 
+DS_API struct ds_event * ds_event_bin_peek (
+  struct ds_event_bin *         self
+);
+
 DS_API bool ds_event_bin_is_empty (
   struct ds_event_bin *         self
 );
 
+/// same scheme as `struct ds_event_magazine` and `struct ds_event_cache`,
+/// for bins
+struct ds_event_bin_magazine {
+  struct ds_event_bin_magazine * next;
+  unsigned int                  num_bins;
+  struct ds_event_bin *         bins [ DS_MAGAZINE_SIZE ];
+};
+
+struct ds_event_bin_cache {
+  _Alignas(64) struct ds_event_bin_pool * pool;
+  struct ds_event_bin_magazine * loaded;
+  struct ds_event_bin_magazine * previous;
+  unsigned long long            num_exchanges;
+  _Atomic bool                  is_attached;
+};
+
 struct ds_event_bin_pool {
   struct ds_event_bin *         bins;
   unsigned int                  max_bins;
   struct ds_event_bin *         free_bin;
+  struct ds_event_bin_cache *   caches;
+  unsigned int                  num_caches;
+  struct ds_event_bin_magazine * magazines;
+  unsigned int                  num_magazines;
+  struct ds_event_bin_magazine * full_magazine;
+  struct ds_event_bin_magazine * empty_magazine;
+  struct ds_event_bin_magazine * partial_magazine;
+  pthread_mutex_t               lock;
+  enum ds_memory_flags          flags;
 };
 
 DS_API bool ds_event_bin_pool_initialize (
   struct ds_event_bin_pool *    self,
-  unsigned int                  max_bins
+  unsigned int                  max_bins,
+  enum ds_memory_flags          flags
 );
 
 DS_API void ds_event_bin_pool_deinitialize (
@@ -137,7 +282,8 @@ DS_API void ds_event_bin_pool_deinitialize (
 
 DS_API struct ds_event_bin * ds_event_bin_pool_acquire (
   struct ds_event_bin_pool *    self,
-  struct ds_event *             event
+  struct ds_event *             event,
+  bool                          is_grouped
 );
 
 DS_API void ds_event_bin_pool_release (
@@ -145,17 +291,90 @@ DS_API void ds_event_bin_pool_release (
   struct ds_event_bin *         bin
 );
 
+DS_API bool ds_event_bin_pool_partition (
+  struct ds_event_bin_pool *    self,
+  unsigned int                  num_caches
+);
+
+DS_API struct ds_event_bin_cache * ds_event_bin_pool_attach (
+  struct ds_event_bin_pool *    self
+);
+
+DS_API void ds_event_bin_pool_detach (
+  struct ds_event_bin_cache *   cache
+);
+
+DS_API struct ds_event_bin * ds_event_bin_cache_acquire (
+  struct ds_event_bin_cache *   self,
+  struct ds_event *             event,
+  bool                          is_grouped
+);
+
+DS_API void ds_event_bin_cache_release (
+  struct ds_event_bin_cache *   self,
+  struct ds_event_bin *         bin
+);
+
+/// adaptive queue tuning: costs are measured in bins visited per operation
+# define DS_EVENT_QUEUE_ADAPT_PERIOD    256U
+# define DS_EVENT_QUEUE_COST_SHIFT      4U
+# define DS_EVENT_QUEUE_HIGH_COST       16U
+# define DS_EVENT_QUEUE_LOW_COST        4U
+/// buckets looked ahead for the next bin to prefetch in calendar mode
+# define DS_EVENT_QUEUE_PREFETCH_SPAN   8U
+# define DS_EVENT_CALENDAR_MIN_BINS     64U
+# define DS_EVENT_CALENDAR_MIN_BUCKETS  16U
+
+enum ds_event_queue_kind {
+  DS_EVENT_QUEUE_KIND_LIST,
+  DS_EVENT_QUEUE_KIND_CALENDAR,
+
+  DS_NUM_EVENT_QUEUE_KINDS
+};
+
+struct ds_event_bucket {
+  struct ds_event_bin *         head;
+  struct ds_event_bin *         tail;
+};
+
+struct ds_event_calendar {
+  struct ds_event_bucket *      buckets;
+  unsigned int                  max_buckets;
+  unsigned int                  num_buckets;
+  unsigned int                  width;
+  unsigned int                  max_time;
+};
+
+struct ds_event_queue_stats {
+  unsigned long long            mean_offset;
+  unsigned int                  list_cost;
+  unsigned int                  calendar_cost;
+  unsigned int                  find_cost;
+  unsigned int                  num_samples;
+  unsigned int                  num_operations;
+  unsigned int                  num_migrations;
+};
+
 struct ds_event_queue {
   struct ds_event_pool          events;
   struct ds_event_bin_pool      bins;
   struct ds_event_bin *         head;
   struct ds_event_bin *         tail;
+  enum ds_event_queue_kind      kind;
+  bool                          is_adaptive;
+  bool                          is_grouped;
+  struct ds_event_calendar      calendar;
+  struct ds_event_queue_stats   stats;
+  unsigned int                  num_events;
+  unsigned int                  num_bins;
 };
 
+/// `flags` applies to both pools: see `enum ds_memory_flags`
 DS_API bool ds_event_queue_initialize (
   struct ds_event_queue *       self,
   unsigned int                  max_events,
-  unsigned int                  max_bins
+  unsigned int                  max_bins,
+  enum ds_memory_flags          flags
 );
 
 DS_API void ds_event_queue_deinitialize (
@@ -169,31 +388,448 @@ DS_API bool ds_event_queue_enqueue (
   void *                        data
 );
 
+/// links `event`, acquired from the pool of the queue, behind the events
+/// sharing its time: ds_event_queue_enqueue() without the allocation
+DS_API bool ds_event_queue_insert (
+  struct ds_event_queue *       self,
+  struct ds_event *             event
+);
+
 DS_API struct ds_event * ds_event_queue_dequeue (
   struct ds_event_queue *       self,
   unsigned int                  time_limit
 );
 
+/// like ds_event_queue_is_empty(), misses the events a pipelined step has
+/// prepared, and races with its preparing thread if split: handlers of such
+/// a step only inspect the queue through the simulator
+DS_API struct ds_event * ds_event_queue_peek (
+  struct ds_event_queue *       self,
+  unsigned int                  time_limit
+);
+
+/// hints the caches at what the next dequeue touches: the earliest events
+/// and the bin after theirs, which a calendar keeps in the next non-empty
+/// bucket unless it is due in the same interval
+DS_API void ds_event_queue_prefetch (
+  struct ds_event_queue *       self
+);
+
 DS_API void ds_event_queue_recycle (
   struct ds_event_queue *       self,
   struct ds_event *             event
 );
 
+/// gives a dequeued event back, ahead of the events sharing its time (and
+/// type, if grouped): requeuing in reverse dequeue order restores the queue
+DS_API bool ds_event_queue_requeue (
+  struct ds_event_queue *       self,
+  struct ds_event *             event
+);
+
 DS_API bool ds_event_queue_is_empty (
   struct ds_event_queue *       self
 );
 
+DS_API bool ds_event_queue_set_adaptive (
+  struct ds_event_queue *       self,
+  bool                          is_adaptive
+);
+
+DS_API void ds_event_queue_sample (
+  struct ds_event_queue *       self,
+  unsigned int                  offset
+);
+
+DS_API enum ds_event_queue_kind ds_event_queue_get_kind (
+  struct ds_event_queue *       self
+);
+
+DS_API unsigned int ds_event_queue_get_num_migrations (
+  struct ds_event_queue *       self
+);
+
+/// in grouped mode, each bin keeps one FIFO list per event type and bins are
+/// drained type by type (in `enum ds_event_type` order): events sharing a
+/// timestamp and a type keep their scheduling order, but events of different
+/// types sharing a timestamp no longer do; the queue has to be empty
+DS_API bool ds_event_queue_set_grouped (
+  struct ds_event_queue *       self,
+  bool                          is_grouped
+);
+
+# define DS_EVENT_SKIPLIST_MAX_LEVEL    16U
+# define DS_EVENT_SKIPLIST_MAX_THREADS  64U
+# define DS_EVENT_SKIPLIST_MAX_OFFSET   32U
+# define DS_EVENT_SKIPLIST_CACHE_SIZE   64U
+# define DS_EVENT_SKIPLIST_QUIESCENT    (~0ULL)
+
+/// the low bit of next[0] marks the successor as deleted
+struct ds_event_skipnode {
+  _Atomic uintptr_t             next [ DS_EVENT_SKIPLIST_MAX_LEVEL ];
+  struct ds_event               event;
+  unsigned long long            sequence;
+  unsigned int                  level;
+  _Atomic bool                  is_inserting;
+  _Atomic unsigned int          free_next;
+  struct ds_event_skipnode *    link;
+};
+
+struct ds_event_skiplist;
+
+/// per-thread handle: announced epoch, retired and free node caches
+struct ds_event_skiplist_thread {
+  _Alignas(64) _Atomic unsigned long long epoch;
+  struct ds_event_skiplist *    list;
+  struct ds_event_skipnode *    free_node;
+  unsigned int                  num_free;
+  struct ds_event_skipnode *    retired [ 3 ];
+  unsigned long long            retired_epochs [ 3 ];
+  unsigned int                  num_retired;
+  unsigned long long            random;
+  _Atomic bool                  is_attached;
+};
+
+/// lock-free priority queue of events (Linden & Jonsson), ordered by time,
+/// then by scheduling order; nodes are reclaimed with epochs
+///
+/// an enqueue only fails once the deleted nodes have been unlinked and the
+/// retired ones reclaimed, so that `max_events` events always fit from a
+/// single thread; with several threads, each other attached thread may keep
+/// up to 2 * DS_EVENT_SKIPLIST_CACHE_SIZE free nodes in its cache, and the
+/// nodes retired by the operations in progress are not reclaimable yet
+struct ds_event_skiplist {
+  struct ds_event_skipnode *    nodes;
+  unsigned int                  max_nodes;
+  struct ds_event_skipnode *    head;
+  struct ds_event_skipnode *    tail;
+  _Alignas(64) _Atomic unsigned long long free_top;
+  _Alignas(64) _Atomic unsigned long long sequence;
+  _Alignas(64) _Atomic unsigned long long epoch;
+  struct ds_event_skiplist_thread threads [ DS_EVENT_SKIPLIST_MAX_THREADS ];
+};
+
+DS_API bool ds_event_skiplist_initialize (
+  struct ds_event_skiplist *    self,
+  unsigned int                  max_events
+);
+
+DS_API void ds_event_skiplist_deinitialize (
+  struct ds_event_skiplist *    self
+);
+
+DS_API struct ds_event_skiplist_thread * ds_event_skiplist_attach (
+  struct ds_event_skiplist *    self
+);
+
+DS_API void ds_event_skiplist_detach (
+  struct ds_event_skiplist_thread * thread
+);
+
+DS_API bool ds_event_skiplist_enqueue (
+  struct ds_event_skiplist_thread * thread,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+);
+
+/// removes the earliest event if it is before `time_limit`, copying it into
+/// `event`: the node itself is reclaimed asynchronously
+DS_API struct ds_event * ds_event_skiplist_dequeue (
+  struct ds_event_skiplist_thread * thread,
+  unsigned int                  time_limit,
+  struct ds_event *             event
+);
+
+/// copies the earliest event into `event` if it is before `time_limit`,
+/// leaving it in the list: only meaningful while no other thread dequeues,
+/// nor enqueues before `time_limit`
+DS_API struct ds_event * ds_event_skiplist_peek (
+  struct ds_event_skiplist_thread * thread,
+  unsigned int                  time_limit,
+  struct ds_event *             event
+);
+
+DS_API bool ds_event_skiplist_is_empty (
+  struct ds_event_skiplist_thread * thread
+);
+
+# define DS_EVENT_BATCH_SIZE  64U
+
+struct ds_sink {
+  char *                        buffers [ 2 ];
+  size_t                        sizes [ 2 ];
+  size_t                        capacity;
+  unsigned int                  active;
+  unsigned int                  next;
+  unsigned int                  num_pending;
+  enum ds_event_format          format;
+  int                           fd;
+  pthread_t                     thread;
+  pthread_mutex_t               lock;
+  pthread_cond_t                filled;
+  pthread_cond_t                flushed;
+  unsigned long long            num_stalls;
+  bool                          is_stopping;
+  bool                          is_okay;
+};
+
+/// double-buffered writer: the owner fills one buffer while a background
+/// thread writes the other to `fd`, in submission order; the owner blocks
+/// (and counts a stall) when both buffers are full
+DS_API bool ds_sink_initialize (
+  struct ds_sink *              self,
+  int                           fd,
+  enum ds_event_format          format,
+  size_t                        capacity
+);
+
+DS_API bool ds_sink_deinitialize (
+  struct ds_sink *              self
+);
+
+DS_API bool ds_sink_write (
+  struct ds_sink *              self,
+  void const *                  data,
+  size_t                        size
+);
+
+DS_API bool ds_sink_write_event (
+  struct ds_sink *              self,
+  struct ds_event *             event
+);
+
+DS_API bool ds_sink_printf (
+  struct ds_sink *              self,
+  char const *                  format,
+  ...
+);
+
+DS_API bool ds_sink_flush (
+  struct ds_sink *              self
+);
+
+/// fixed-size on-disk record of a spilled event; the payload is the bits of
+/// the data pointer, so spilling stays within the owning process
+struct ds_spill_record {
+  uint32_t                      time;
+  uint32_t                      type;
+  uint64_t                      sequence;
+  uint64_t                      data;
+};
+
+struct ds_spill_run {
+  size_t                        offset;
+  size_t                        num_records;
+  size_t                        index;
+};
+
+/// events at or after `horizon` are kept in sorted runs of a temporary file;
+/// a background thread merges the next `window` of time units ahead of use
+struct ds_spill {
+  char *                        directory;
+  int                           fd;
+  size_t                        num_records;
+  struct ds_spill_run *         runs;
+  unsigned int                  num_runs;
+  unsigned int                  max_runs;
+  struct ds_spill_record *      buffer;
+  size_t                        num_buffered;
+  size_t                        max_buffered;
+  struct ds_spill_record *      staging;
+  size_t                        num_staged;
+  size_t                        max_staged;
+  size_t                        staged_index;
+  unsigned int                  horizon;
+  unsigned int                  window;
+  unsigned long long            staging_horizon;
+  unsigned int                  num_staging_runs;
+  size_t                        num_staging_records;
+  unsigned long long            sequence;
+  unsigned long long            num_pending;
+  pthread_t                     thread;
+  pthread_mutex_t               lock;
+  pthread_cond_t                start;
+  pthread_cond_t                done;
+  bool                          is_staging;
+  bool                          is_staged;
+  bool                          is_stopping;
+  bool                          is_okay;
+};
+
+DS_API bool ds_spill_initialize (
+  struct ds_spill *             self,
+  char const *                  directory,
+  unsigned int                  window,
+  size_t                        max_buffered,
+  unsigned int                  max_runs
+);
+
+DS_API void ds_spill_deinitialize (
+  struct ds_spill *             self
+);
+
+DS_API bool ds_spill_append (
+  struct ds_spill *             self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+);
+
+/// moves the horizon past `time_limit`, enqueuing the spilled events before
+/// it; the queue has to be able to hold a whole window of events
+DS_API bool ds_spill_refill (
+  struct ds_spill *             self,
+  struct ds_event_queue *       queue,
+  unsigned int                  time_limit
+);
+
+DS_API unsigned long long ds_spill_clear (
+  struct ds_spill *             self
+);
+
+DS_API bool ds_spill_is_empty (
+  struct ds_spill *             self
+);
+
+struct ds_simulator;
+
+/// layout of the shared-memory segment, duplicated in ash-top.c: bump the
+/// version on any change
+# define DS_TELEMETRY_MAGIC             0x54485341U
+# define DS_TELEMETRY_VERSION           1U
+# define DS_TELEMETRY_MAX_TYPES         32U
+# define DS_TELEMETRY_NAME_SIZE         16U
+/// steps between two updates of the dispatch rate
+# define DS_TELEMETRY_RATE_PERIOD       256U
+
+/// written by the simulator after every step under a sequence lock (odd
+/// while being written); readers copy it, then retry if the sequence moved
+struct ds_telemetry_segment {
+  _Atomic uint32_t              magic;
+  uint32_t                      version;
+  uint32_t                      pid;
+  uint32_t                      num_types;
+  _Atomic uint64_t              sequence;
+  _Atomic uint64_t              time;
+  _Atomic uint64_t              time_step;
+  _Atomic uint64_t              num_steps;
+  _Atomic uint64_t              num_events;
+  _Atomic uint64_t              events_per_second;
+  _Atomic uint64_t              num_pending_events;
+  _Atomic uint64_t              num_bins;
+  _Atomic uint64_t              max_events;
+  _Atomic uint64_t              max_bins;
+  _Atomic uint64_t              num_type_events [ DS_TELEMETRY_MAX_TYPES ];
+  char                          type_names [ DS_TELEMETRY_MAX_TYPES ][ DS_TELEMETRY_NAME_SIZE ];
+};
+
+struct ds_telemetry {
+  struct ds_telemetry_segment * segment;
+  char                          name [ 64 ];
+  unsigned long long            num_steps;
+  unsigned long long            clock;
+  unsigned long long            num_events;
+  unsigned long long            events_per_second;
+};
+
+/// creates the POSIX shared-memory segment `name` ("/ash-<pid>" if NULL),
+/// for ash-top to attach to
+DS_API bool ds_telemetry_initialize (
+  struct ds_telemetry *         self,
+  char const *                  name
+);
+
+/// unlinks the segment: attached readers notice and stop
+DS_API void ds_telemetry_deinitialize (
+  struct ds_telemetry *         self
+);
+
+DS_API void ds_telemetry_publish (
+  struct ds_telemetry *         self,
+  struct ds_simulator *         simulator
+);
+
+/// in 32-bit words, four per Philox block
+# define DS_RANDOM_BUFFER_SIZE          256U
+
+/// Philox4x32-10 stream: block `counter` of stream `stream` under key `seed`
+/// is a pure function of the three, so a stream draws the same numbers
+/// whichever thread runs it and whenever; blocks are generated in bulk
+struct ds_random {
+  uint64_t                      seed;
+  uint64_t                      stream;
+  uint64_t                      counter;
+  unsigned int                  index;
+  uint32_t                      buffer [ DS_RANDOM_BUFFER_SIZE ];
+};
+
+DS_API void ds_random_initialize (
+  struct ds_random *            self,
+  uint64_t                      seed,
+  uint64_t                      stream
+);
+
+DS_API uint32_t ds_random_next (
+  struct ds_random *            self
+);
+
+/// in [0;1), with 53 random bits
+DS_API double ds_random_uniform (
+  struct ds_random *            self
+);
+
+DS_API double ds_random_exponential (
+  struct ds_random *            self,
+  double                        mean
+);
+
+/// same values as `num_values` calls to ds_random_uniform()
+DS_API void ds_random_fill_uniform (
+  struct ds_random *            self,
+  double *                      values,
+  size_t                        num_values
+);
+
+/// same values as `num_values` calls to ds_random_exponential()
+DS_API void ds_random_fill_exponential (
+  struct ds_random *            self,
+  double *                      values,
+  size_t                        num_values,
+  double                        mean
+);
+
+struct ds_pipeline;
+
+typedef void (* ds_event_batch_handler) (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+);
+
 struct ds_simulator {
   struct ds_event_queue         queue;
   unsigned int                  time;
   unsigned int                  time_step;
+  ds_event_batch_handler        batch_handlers [ DS_NUM_EVENT_TYPES ];
+  struct ds_sink *              sink;
+  struct ds_spill *             spill;
+  struct ds_telemetry *         telemetry;
+  unsigned long long            num_type_events [ DS_NUM_EVENT_TYPES ];
+  uint64_t                      seed;
+  struct ds_pipeline *          pipeline;
+  struct ds_event_skiplist_thread * timeline;
+  bool                          is_stalled;
 };
 
 DS_API bool ds_simulator_initialize (
   struct ds_simulator *         self,
   unsigned int                  max_events,
   unsigned int                  max_bins,
-  unsigned int                  time_step
+  unsigned int                  time_step,
+  enum ds_memory_flags          flags
 );
 
 DS_API void ds_simulator_deinitialize (
@@ -207,835 +843,10089 @@ DS_API bool ds_simulator_schedule (
   void *                        data
 );
 
+/// schedules `event`, acquired from the pool of the simulator's queue, as
+/// ds_simulator_schedule() would schedule its fields; on failure, the event
+/// is left to the caller
+DS_API bool ds_simulator_insert (
+  struct ds_simulator *         self,
+  struct ds_event *             event
+);
+
+/// when the spilled events of the step cannot all be merged back into the
+/// queue, the step does not start: no event is dispatched, the time stays and
+/// `is_stalled` is set until a step starts again
 DS_API unsigned int ds_simulator_simulate (
   struct ds_simulator *         self
 );
 
+/// counts the events a pipelined step has prepared, under the lock of the
+/// pipeline if split, so that its handlers may call it
 DS_API bool ds_simulator_is_empty (
   struct ds_simulator *         self
 );
 
+/// recycles the pending events, spilled ones and those of the timeline
+/// included, without processing them: the processes they would have resumed
+/// are dropped
 DS_API unsigned int ds_simulator_drain (
   struct ds_simulator *         self
 );
 
-/// MAIN
+/// consecutive events of the same type and time are handed to the batch
+/// handler together (up to DS_EVENT_BATCH_SIZE payloads per call) instead of
+/// being processed one by one; combine with ds_event_queue_set_grouped() to
+/// make such runs as long as possible
+DS_API bool ds_simulator_set_batch_handler (
+  struct ds_simulator *         self,
+  enum ds_event_type            type,
+  ds_event_batch_handler        handler
+);
 
-# include <stdint.h>
+/// recycles the pending events, then rewinds the clock, the counters and the
+/// queue to their state after initialization: the queue is a list again and
+/// has forgotten its estimates; handlers, sink, seed and modes are kept
+DS_API void ds_simulator_reset (
+  struct ds_simulator *         self
+);
 
-int main ( int argc, char const * const * argv )
-{
-  (void)argc;
-  (void)argv;
+/// every dispatched event is written to the sink first, if any
+DS_API void ds_simulator_set_sink (
+  struct ds_simulator *         self,
+  struct ds_sink *              sink
+);
 
-  struct ds_simulator simulator;
+/// events scheduled `window` time units or more ahead of the current time
+/// go to `spill` (if any), and come back to the queue as time gets closer;
+/// nothing may be spilled yet
+DS_API void ds_simulator_set_spill (
+  struct ds_simulator *         self,
+  struct ds_spill *             spill
+);
 
-  if ( !ds_simulator_initialize(&simulator, 1024U, 256U, 1U) )
-    return EXIT_FAILURE;
+/// with a `timeline`, the simulator's own handle on a skip list, events are
+/// scheduled into that list instead of the queue, and steps delete the
+/// earliest ones from it; other threads attached to the same list enqueue
+/// into it concurrently, at times past the step in progress, and only the
+/// simulator dequeues; the queue has to be empty, without a spill, and steps
+/// are not pipelined
+DS_API bool ds_simulator_set_timeline (
+  struct ds_simulator *         self,
+  struct ds_event_skiplist_thread * timeline
+);
 
-  int exit_code = EXIT_SUCCESS;
+/// publishes to `telemetry` after every step, if any
+DS_API void ds_simulator_set_telemetry (
+  struct ds_simulator *         self,
+  struct ds_telemetry *         telemetry
+);
 
-  for ( int index = 0; index < 10; ++index ) {
-    fprintf(stdout, ">>> Scheduling event %d...\n", index);
-    bool is_okay  = ds_simulator_schedule(&simulator,
-      (unsigned int)( index >> 1U ),
-      DS_EVENT_TYPE_CUSTOM,
-      (void *)&simulator
-    );
+DS_API void ds_simulator_set_seed (
+  struct ds_simulator *         self,
+  uint64_t                      seed
+);
 
-    if ( !is_okay ) {
-      exit_code = EXIT_FAILURE;
-      break;
-    }
-    fprintf(stdout, "... Scheduled event %d.\n", index);
-  }
+/// one stream per entity (or logical process) keeps the numbers it draws
+/// independent of the order entities happen to be dispatched in
+DS_API void ds_simulator_open_random (
+  struct ds_simulator *         self,
+  struct ds_random *            random,
+  uint64_t                      stream
+);
 
-  if ( EXIT_SUCCESS == exit_code ) {
-    unsigned int max_steps  = 1024U * 1024U;
-    unsigned int num_steps;
+# define DS_PIPELINE_MAX_DEPTH  64U
+
+/// ring of the next `depth` events of the step, dequeued (their payloads
+/// prefetched) ahead of their dispatch, either in between dispatches or by a
+/// preparing thread; the ring is consumed from `head`, and filled at `tail`
+/// under `lock` when split
+struct ds_pipeline {
+  struct ds_event *             events [ DS_PIPELINE_MAX_DEPTH ];
+  _Atomic unsigned int          head;
+  _Atomic unsigned int          tail;
+  unsigned int                  depth;
+  unsigned int                  time_limit;
+  struct ds_event_queue *       queue;
+  unsigned long long            num_requeues;
+  pthread_t                     thread;
+  pthread_mutex_t               lock;
+  pthread_cond_t                ready;
+  _Atomic bool                  is_waiting;
+  bool                          is_active;
+  bool                          is_stopping;
+  bool                          is_split;
+};
 
-    for ( num_steps = 0; num_steps < max_steps; ++num_steps ) {
-      fprintf(stdout, "\n### =========================\n");
-      fprintf(stdout, ">>> Processing t=%u, dt=%u...\n",
-        simulator.time,
-        simulator.time_step
-      );
-      unsigned int num_events = ds_simulator_simulate(&simulator);
-      fprintf(stdout, "... Processed %u events.\n", num_events);
-      fprintf(stdout, "### =========================\n");
+/// `is_split` prepares events on a thread of its own, the queue being
+/// shared behind a mutex; otherwise, preparing is interleaved with dispatching
+DS_API bool ds_pipeline_initialize (
+  struct ds_pipeline *          self,
+  unsigned int                  depth,
+  bool                          is_split
+);
 
-      if ( ds_simulator_is_empty(&simulator) )
-        break;
-    }
-    fprintf(stdout, "Simulated %u step%s.\nEnd of Simulation.\n",
-      num_steps,
-      num_steps == 1U ? "" : "s"
-    );
+DS_API void ds_pipeline_deinitialize (
+  struct ds_pipeline *          self
+);
+
+/// same step as ds_simulator_simulate(), with the events dispatched in the
+/// same order: the prepared events a handler schedules ahead of are requeued
+DS_API unsigned int ds_simulator_simulate_pipelined (
+  struct ds_simulator *         self,
+  struct ds_pipeline *          pipeline
+);
+
+/// stack pointer saved by a context switch, the callee-saved registers
+/// being pushed on the stack itself
+struct ds_process_context {
+  void *                        stack_pointer;
+};
+
+/// switches stacks: saves the callee-saved registers of the caller on its
+/// stack and its stack pointer into `from`, then does the reverse from `to`
+DS_API void ds_process_context_switch (
+  struct ds_process_context *   from,
+  struct ds_process_context *   to
+);
+
+enum ds_process_state {
+  DS_PROCESS_STATE_FREE,
+  DS_PROCESS_STATE_SCHEDULED,
+  DS_PROCESS_STATE_RUNNING,
+  DS_PROCESS_STATE_PASSIVE,
+  DS_PROCESS_STATE_TERMINATED,
+};
+
+struct ds_process;
+
+typedef void (* ds_process_body) (
+  struct ds_process *           process,
+  void *                        argument
+);
+
+struct ds_process {
+  struct ds_process_context     context;
+  struct ds_process *           next;
+  struct ds_process_arena *     arena;
+  struct ds_simulator *         simulator;
+  ds_process_body               body;
+  void *                        argument;
+  char *                        stack;
+  unsigned int                  time;
+  enum ds_process_state         state;
+};
+
+/// fixed-size stacks carved out of a single lazily-committed mapping, so
+/// that idle processes only cost the pages they touched; stacks have no
+/// guard page, and keep what they committed once recycled
+struct ds_process_arena {
+  struct ds_process *           processes;
+  char *                        stacks;
+  size_t                        stack_size;
+  unsigned int                  max_processes;
+  unsigned int                  num_processes;
+  struct ds_process *           free_process;
+  struct ds_process *           current;
+  struct ds_process_context     scheduler;
+};
+
+DS_API bool ds_process_arena_initialize (
+  struct ds_process_arena *     self,
+  unsigned int                  max_processes,
+  size_t                        stack_size
+);
+
+/// processes that are still alive are dropped along with their stacks: the
+/// simulators they were spawned into have to be drained first, as their
+/// pending DS_EVENT_TYPE_PROCESS events would resume freed processes
+DS_API void ds_process_arena_deinitialize (
+  struct ds_process_arena *     self
+);
+
+/// starts `body` at `time` on its own stack, as a DS_EVENT_TYPE_PROCESS event
+DS_API struct ds_process * ds_process_spawn (
+  struct ds_process_arena *     arena,
+  struct ds_simulator *         simulator,
+  unsigned int                  time,
+  ds_process_body               body,
+  void *                        argument
+);
+
+/// switches to `self` until it holds, passivates or returns; called when
+/// its DS_EVENT_TYPE_PROCESS event is processed
+DS_API void ds_process_resume (
+  struct ds_process *           self,
+  unsigned int                  time
+);
+
+/// from within `self`: suspends it for `delay` time units
+DS_API bool ds_process_hold (
+  struct ds_process *           self,
+  unsigned int                  delay
+);
+
+/// from within `self`: suspends it until activated
+DS_API void ds_process_passivate (
+  struct ds_process *           self
+);
+
+/// from anywhere: resumes a passive process at `time`
+DS_API bool ds_process_activate (
+  struct ds_process *           self,
+  unsigned int                  time
+);
+
+/// `capacity` units, each held by one requester at a time; requests that
+/// cannot be granted wait in FIFO order as their own pooled events, linked
+/// into the queue once granted, so that waiting costs no allocation
+struct ds_resource {
+  struct ds_simulator *         simulator;
+  struct ds_event_list          waiters;
+  unsigned int                  capacity;
+  unsigned int                  num_busy;
+  unsigned int                  num_waiters;
+  unsigned long long            num_requests;
+  unsigned long long            num_waits;
+  unsigned long long            wait_time;
+};
+
+DS_API bool ds_resource_initialize (
+  struct ds_resource *          self,
+  struct ds_simulator *         simulator,
+  unsigned int                  capacity
+);
+
+/// waiting requests are dropped, their events going back to the pool
+DS_API void ds_resource_deinitialize (
+  struct ds_resource *          self
+);
+
+/// schedules the `type` event of `data` once a unit is granted, at `time` if
+/// one is free
+DS_API bool ds_resource_request (
+  struct ds_resource *          self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+);
+
+/// hands the unit over to the earliest waiting request, if any
+DS_API bool ds_resource_release (
+  struct ds_resource *          self,
+  unsigned int                  time
+);
+
+/// up to `capacity` items in FIFO order; an item and a blocked put are one
+/// pooled event each, a blocked get reuses its own event to carry the item
+struct ds_store {
+  struct ds_simulator *         simulator;
+  struct ds_event_list          items;
+  struct ds_event_list          getters;
+  struct ds_event_list          putters;
+  struct ds_event_list          pending_items;
+  unsigned int                  capacity;
+  unsigned int                  num_items;
+};
+
+DS_API bool ds_store_initialize (
+  struct ds_store *             self,
+  struct ds_simulator *         simulator,
+  unsigned int                  capacity
+);
+
+/// items and waiting operations are dropped, their events going back to the
+/// pool
+DS_API void ds_store_deinitialize (
+  struct ds_store *             self
+);
+
+/// schedules the `type` event of `data` once `item` is in the store (or
+/// handed to a waiting get)
+DS_API bool ds_store_put (
+  struct ds_store *             self,
+  unsigned int                  time,
+  void *                        item,
+  enum ds_event_type            type,
+  void *                        data
+);
+
+/// schedules a `type` event carrying the earliest item as its data
+DS_API bool ds_store_get (
+  struct ds_store *             self,
+  unsigned int                  time,
+  enum ds_event_type            type
+);
+
+/// a level in [0;capacity]; puts and gets of an amount are served in FIFO
+/// order, each blocked one keeping its amount in a second pooled event
+struct ds_container {
+  struct ds_simulator *         simulator;
+  struct ds_event_list          getters;
+  struct ds_event_list          get_amounts;
+  struct ds_event_list          putters;
+  struct ds_event_list          put_amounts;
+  unsigned int                  capacity;
+  unsigned int                  level;
+};
+
+DS_API bool ds_container_initialize (
+  struct ds_container *         self,
+  struct ds_simulator *         simulator,
+  unsigned int                  capacity,
+  unsigned int                  level
+);
+
+/// waiting operations are dropped, their events going back to the pool
+DS_API void ds_container_deinitialize (
+  struct ds_container *         self
+);
+
+/// schedules the `type` event of `data` once `amount` has been added
+DS_API bool ds_container_put (
+  struct ds_container *         self,
+  unsigned int                  time,
+  unsigned int                  amount,
+  enum ds_event_type            type,
+  void *                        data
+);
+
+/// schedules the `type` event of `data` once `amount` has been removed
+DS_API bool ds_container_get (
+  struct ds_container *         self,
+  unsigned int                  time,
+  unsigned int                  amount,
+  enum ds_event_type            type,
+  void *                        data
+);
+
+/// runs one replication on a freshly reset simulator, seeded with the
+/// replication number, writing into `result`
+typedef bool (* ds_ensemble_replicate) (
+  struct ds_simulator *         simulator,
+  unsigned int                  replication,
+  void *                        result,
+  void *                        context
+);
+
+/// folds `result` into `accumulator`; all-zero bytes is the identity
+typedef void (* ds_ensemble_reduce) (
+  void *                        accumulator,
+  void const *                  result,
+  void *                        context
+);
+
+struct ds_ensemble;
+
+struct ds_ensemble_worker {
+  /// packed [begin;end) of the replications left, stolen from the end
+  _Alignas(64) _Atomic unsigned long long range;
+  struct ds_ensemble *          ensemble;
+  struct ds_simulator           simulator;
+  pthread_t                     thread;
+  unsigned char *               result;
+  unsigned char *               accumulator;
+  unsigned int                  index;
+  unsigned int                  num_replications;
+  bool                          is_okay;
+};
+
+struct ds_ensemble {
+  struct ds_ensemble_worker *   workers;
+  unsigned int                  num_workers;
+  unsigned int                  max_events;
+  unsigned int                  max_bins;
+  unsigned int                  time_step;
+  size_t                        result_size;
+  ds_ensemble_replicate         replicate;
+  ds_ensemble_reduce            reduce;
+  void *                        context;
+  pthread_mutex_t               lock;
+  pthread_cond_t                start;
+  pthread_cond_t                done;
+  unsigned int                  generation;
+  unsigned int                  num_ready;
+  unsigned int                  num_done;
+  bool                          is_stopping;
+};
+
+/// `num_workers` of 0 uses one worker per online core; every worker owns a
+/// simulator preallocated on its own thread and reused across replications
+DS_API bool ds_ensemble_initialize (
+  struct ds_ensemble *          self,
+  unsigned int                  num_workers,
+  unsigned int                  max_events,
+  unsigned int                  max_bins,
+  unsigned int                  time_step,
+  size_t                        result_size
+);
+
+DS_API void ds_ensemble_deinitialize (
+  struct ds_ensemble *          self
+);
+
+/// partial results are reduced per worker, then worker by worker into
+/// `result`: non-associative reductions depend on the work distribution
+DS_API bool ds_ensemble_run (
+  struct ds_ensemble *          self,
+  unsigned int                  num_replications,
+  ds_ensemble_replicate         replicate,
+  ds_ensemble_reduce            reduce,
+  void *                        context,
+  void *                        result
+);
+
+struct ds_realtime_stats {
+  unsigned long long            num_steps;
+  unsigned long long            num_late_steps;
+  unsigned long long            last_lateness;
+  unsigned long long            max_lateness;
+  unsigned long long            total_lateness;
+};
+
+/// maps simulated time to CLOCK_MONOTONIC nanoseconds, `time_scale` per unit,
+/// anchoring the current simulated time to the current wall-clock time
+struct ds_realtime {
+  unsigned long long            origin;
+  unsigned int                  time_origin;
+  unsigned long long            time_scale;
+  unsigned long long            spin_time;
+  struct ds_realtime_stats      stats;
+};
+
+DS_API bool ds_realtime_initialize (
+  struct ds_realtime *          self,
+  struct ds_simulator *         simulator,
+  unsigned long long            time_scale,
+  unsigned long long            spin_time
+);
+
+DS_API void ds_realtime_deinitialize (
+  struct ds_realtime *          self
+);
+
+DS_API unsigned long long ds_realtime_deadline (
+  struct ds_realtime *          self,
+  unsigned int                  time
+);
+
+DS_API void ds_realtime_wait (
+  struct ds_realtime *          self,
+  unsigned long long            deadline
+);
+
+/// sleeps until the wall-clock deadline of the next pending timestamp (on an
+/// absolute deadline, spinning for the last `spin_time` nanoseconds), skips
+/// the empty steps before it, then simulates that step like
+/// ds_simulator_simulate(); the lateness of the step is added to the stats
+DS_API unsigned int ds_simulator_simulate_realtime (
+  struct ds_simulator *         self,
+  struct ds_realtime *          realtime
+);
+
+# define DS_REACTOR_BATCH_SIZE  256U
+
+/// reads what is available on `fd` and schedules the matching events, at or
+/// after `simulator->time`; returning false unregisters the descriptor
+typedef bool (* ds_reactor_decode) (
+  struct ds_simulator *         simulator,
+  int                           fd,
+  void *                        context
+);
+
+struct ds_reactor_source {
+  struct ds_reactor_source *    next;
+  ds_reactor_decode             decode;
+  void *                        context;
+  int                           fd;
+};
+
+struct ds_reactor {
+  struct ds_reactor_source *    sources;
+  unsigned int                  max_sources;
+  struct ds_reactor_source *    free_source;
+  struct ds_reactor_source *    retired_source;
+  unsigned int                  num_sources;
+  int                           epoll_fd;
+  int                           timer_fd;
+  bool                          is_dispatching;
+};
+
+DS_API bool ds_reactor_initialize (
+  struct ds_reactor *           self,
+  unsigned int                  max_sources
+);
+
+DS_API void ds_reactor_deinitialize (
+  struct ds_reactor *           self
+);
+
+DS_API struct ds_reactor_source * ds_reactor_register (
+  struct ds_reactor *           self,
+  int                           fd,
+  ds_reactor_decode             decode,
+  void *                        context
+);
+
+/// from a decoder, the slot of `source` is only reused after the batch of
+/// descriptors being dispatched, which may still report it
+DS_API void ds_reactor_unregister (
+  struct ds_reactor *           self,
+  struct ds_reactor_source *    source
+);
+
+/// decodes readable descriptors while blocking in epoll_wait() until the
+/// deadline of the next pending timestamp (a timerfd on the same clock as
+/// `realtime`), then simulates that step like ds_simulator_simulate_realtime()
+DS_API unsigned int ds_simulator_simulate_reactive (
+  struct ds_simulator *         self,
+  struct ds_reactor *           reactor,
+  struct ds_realtime *          realtime
+);
+
+/// MAIN
+
+# include <errno.h>
+# include <fcntl.h>
+# include <limits.h>
+# include <sched.h>
+# include <unistd.h>
+# include <string.h>
+# include <time.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <linux/perf_event.h>
+
+# include "ash-static.h"
+
+# define DS_BENCHMARK_MAX_THREADS   64U
+# define DS_BENCHMARK_NUM_EVENTS    256U
+# define DS_BENCHMARK_NUM_ROUNDS    4096U
+# define DS_BENCHMARK_SEED          0x9E3779B97F4A7C15ULL
+
+/// xorshift64, drawing the offsets of the benchmarks and tests: unlike the
+/// streams of a simulator, `state` can be shared by both engines of
+/// benchmark-static, or kept by a thread of its own
+static inline unsigned int ds_benchmark_next (
+  unsigned long long *          state
+)
+{
+  *state ^= *state << 13U;
+  *state ^= *state >> 7U;
+  *state ^= *state << 17U;
+
+  return (unsigned int)*state;
+}
+
+/// each thread acquires a batch of events per round, then releases half of
+/// its own batch and half of its neighbour's: with a shared pool behind a
+/// mutex, or with one cache per thread, the first thread using the cache of
+/// the pool itself as the simulator would
+struct ds_benchmark_pool {
+  struct ds_event_pool          pool;
+  pthread_mutex_t               lock;
+  pthread_barrier_t             barrier;
+  struct ds_event *             events [ DS_BENCHMARK_MAX_THREADS ][ DS_BENCHMARK_NUM_EVENTS ];
+  unsigned int                  num_threads;
+  bool                          is_cached;
+};
+
+struct ds_benchmark_pool_thread {
+  struct ds_benchmark_pool *    benchmark;
+  unsigned int                  index;
+  pthread_t                     thread;
+};
+
+static void * ds_benchmark_pool_main (
+  void *                        argument
+)
+{
+  struct ds_benchmark_pool_thread * thread    = (struct ds_benchmark_pool_thread *)argument;
+  struct ds_benchmark_pool *        benchmark = thread->benchmark;
+  struct ds_event_cache *           cache     = (struct ds_event_cache *)NULL;
+  struct ds_event **                own       = benchmark->events[ thread->index ];
+  struct ds_event **                other     = benchmark->events[
+    ( thread->index + 1U ) % benchmark->num_threads
+  ];
+  unsigned int                      half      = DS_BENCHMARK_NUM_EVENTS / 2U;
+
+  if ( benchmark->is_cached ) {
+    cache = 0U == thread->index ? benchmark->pool.caches : ds_event_pool_attach(&benchmark->pool);
+  }
+
+  for ( unsigned int round = 0U; round < DS_BENCHMARK_NUM_ROUNDS; ++round ) {
+    for ( unsigned int index = 0U; index < DS_BENCHMARK_NUM_EVENTS; ++index ) {
+      if ( 0U == thread->index && NULL != (void *)cache ) {
+        own[ index ]  = ds_event_pool_acquire(&benchmark->pool, round, DS_EVENT_TYPE_CUSTOM, NULL);
+      } else if ( NULL != (void *)cache ) {
+        own[ index ]  = ds_event_cache_acquire(cache, round, DS_EVENT_TYPE_CUSTOM, NULL);
+      } else {
+        pthread_mutex_lock(&benchmark->lock);
+        own[ index ]  = ds_event_pool_acquire(&benchmark->pool, round, DS_EVENT_TYPE_CUSTOM, NULL);
+        pthread_mutex_unlock(&benchmark->lock);
+      }
+    }
+
+    pthread_barrier_wait(&benchmark->barrier);
+
+    for ( unsigned int index = 0U; index < DS_BENCHMARK_NUM_EVENTS; ++index ) {
+      struct ds_event * event = index < half ? own[ index ] : other[ index ];
+
+      if ( 0U == thread->index && NULL != (void *)cache ) {
+        ds_event_pool_release(&benchmark->pool, event);
+      } else if ( NULL != (void *)cache ) {
+        ds_event_cache_release(cache, event);
+      } else {
+        pthread_mutex_lock(&benchmark->lock);
+        ds_event_pool_release(&benchmark->pool, event);
+        pthread_mutex_unlock(&benchmark->lock);
+      }
+    }
+
+    pthread_barrier_wait(&benchmark->barrier);
+  }
+
+  if ( 0U != thread->index && NULL != (void *)cache ) {
+    ds_event_pool_detach(cache);
+  }
+
+  return NULL;
+}
+
+static double ds_benchmark_pool_run (
+  unsigned int                  num_threads,
+  bool                          is_cached
+)
+{
+  static struct ds_benchmark_pool           benchmark;
+  static struct ds_benchmark_pool_thread    threads [ DS_BENCHMARK_MAX_THREADS ];
+
+  /// twice a batch per thread: remote frees land before being reclaimed
+  if ( !ds_event_pool_initialize(&benchmark.pool,
+    2U * num_threads * DS_BENCHMARK_NUM_EVENTS,
+    DS_MEMORY_DEFAULT
+  ) )
+    return 0.0;
+
+  if ( is_cached && !ds_event_pool_partition(&benchmark.pool, num_threads) ) {
+    ds_event_pool_deinitialize(&benchmark.pool);
+    return 0.0;
+  }
+
+  pthread_mutex_init(&benchmark.lock, NULL);
+  pthread_barrier_init(&benchmark.barrier, NULL, num_threads);
+  benchmark.num_threads = num_threads;
+  benchmark.is_cached   = is_cached;
+
+  struct timespec begin;
+  struct timespec end;
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+
+  for ( unsigned int index = 0U; index < num_threads; ++index ) {
+    threads[ index ].benchmark  = &benchmark;
+    threads[ index ].index      = index;
+    pthread_create(&threads[ index ].thread, NULL, ds_benchmark_pool_main, threads + index);
+  }
+
+  for ( unsigned int index = 0U; index < num_threads; ++index ) {
+    pthread_join(threads[ index ].thread, NULL);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  pthread_barrier_destroy(&benchmark.barrier);
+  pthread_mutex_destroy(&benchmark.lock);
+  ds_event_pool_deinitialize(&benchmark.pool);
+
+  double seconds  = (double)( end.tv_sec - begin.tv_sec )
+    + 1e-9 * (double)( end.tv_nsec - begin.tv_nsec );
+
+  /// one acquisition and one release per event
+  return 2.0 * num_threads * DS_BENCHMARK_NUM_ROUNDS * DS_BENCHMARK_NUM_EVENTS / seconds;
+}
+
+static int ds_benchmark_pool (void)
+{
+  printf("%8s %16s %16s\n", "threads", "locked (op/s)", "cached (op/s)");
+
+  for ( unsigned int num_threads = 1U; num_threads <= DS_BENCHMARK_MAX_THREADS; num_threads *= 2U ) {
+    double num_locked = ds_benchmark_pool_run(num_threads, false);
+    double num_cached = ds_benchmark_pool_run(num_threads, true);
+
+    if ( 0.0 == num_locked || 0.0 == num_cached )
+      return EXIT_FAILURE;
+
+    printf("%8u %16.0f %16.0f\n", num_threads, num_locked, num_cached);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+# define DS_BENCHMARK_TLB_NUM_EVENTS  ( 4U * 1024U * 1024U )
+# define DS_BENCHMARK_TLB_SPAN        1024U
+
+/// every event is rescheduled at a random offset: once the free list has
+/// been shuffled, consecutive dispatches land on unrelated pages
+static unsigned long long ds_benchmark_tlb_random = DS_BENCHMARK_SEED;
+
+static void ds_benchmark_tlb_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    ds_simulator_schedule(simulator,
+      time + 1U + ds_benchmark_next(&ds_benchmark_tlb_random) % DS_BENCHMARK_TLB_SPAN,
+      type,
+      data[ index ]
+    );
+  }
+}
+
+/// counts the data TLB read misses of this thread, in user space
+static int ds_benchmark_tlb_open (void)
+{
+  struct perf_event_attr attributes;
+
+  memset(&attributes, 0, sizeof(attributes));
+  attributes.type           = PERF_TYPE_HW_CACHE;
+  attributes.size           = sizeof(attributes);
+  attributes.config         = PERF_COUNT_HW_CACHE_DTLB
+    | ( PERF_COUNT_HW_CACHE_OP_READ << 8U )
+    | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16U );
+  attributes.disabled       = 1U;
+  attributes.exclude_kernel = 1U;
+  attributes.exclude_hv     = 1U;
+
+  return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0UL);
+}
+
+static bool ds_benchmark_tlb_run (
+  unsigned int                  num_events,
+  enum ds_memory_flags          flags,
+  double *                      num_dispatches,
+  double *                      num_misses
+)
+{
+  struct ds_simulator simulator;
+
+  /// a batch is rescheduled before being recycled
+  bool is_okay  = ds_simulator_initialize(&simulator,
+    num_events + DS_EVENT_BATCH_SIZE,
+    2U * DS_BENCHMARK_TLB_SPAN,
+    1U,
+    flags
+  );
+
+  if ( !is_okay )
+    return false;
+
+  ds_event_queue_set_adaptive(&simulator.queue, true);
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_benchmark_tlb_handle);
+
+  for ( unsigned int index = 0U; index < num_events; ++index ) {
+    ds_simulator_schedule(&simulator,
+      ds_benchmark_next(&ds_benchmark_tlb_random) % DS_BENCHMARK_TLB_SPAN,
+      DS_EVENT_TYPE_CUSTOM,
+      NULL
+    );
+  }
+
+  /// warm up: shuffle the free list
+  for ( unsigned int step = 0U; step < DS_BENCHMARK_TLB_SPAN; ++step ) {
+    ds_simulator_simulate(&simulator);
+  }
+
+  int                 counter       = ds_benchmark_tlb_open();
+  unsigned long long  num_events_processed = 0ULL;
+  unsigned long long  num_tlb_misses = 0ULL;
+  struct timespec     begin;
+  struct timespec     end;
+
+  if ( 0 <= counter ) {
+    ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+    ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+
+  for ( unsigned int step = 0U; step < 2U * DS_BENCHMARK_TLB_SPAN; ++step ) {
+    num_events_processed += ds_simulator_simulate(&simulator);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  if ( 0 <= counter ) {
+    ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+
+    if ( sizeof(num_tlb_misses) != read(counter, &num_tlb_misses, sizeof(num_tlb_misses)) ) {
+      num_tlb_misses  = 0ULL;
+    }
+
+    close(counter);
+  }
+
+  ds_simulator_drain(&simulator);
+  ds_simulator_deinitialize(&simulator);
+
+  double seconds  = (double)( end.tv_sec - begin.tv_sec )
+    + 1e-9 * (double)( end.tv_nsec - begin.tv_nsec );
+
+  *num_dispatches = (double)num_events_processed / seconds;
+  *num_misses     = 0 <= counter
+    ? (double)num_tlb_misses / (double)num_events_processed : -1.0;
+
+  return true;
+}
+
+static int ds_benchmark_tlb (
+  unsigned int                  num_events
+)
+{
+  static struct {
+    char const *                name;
+    enum ds_memory_flags        flags;
+  } const configurations [] = {
+    { "default",              DS_MEMORY_DEFAULT },
+    { "huge pages",           DS_MEMORY_HUGE_PAGES },
+    { "huge pages, local",    DS_MEMORY_HUGE_PAGES | DS_MEMORY_LOCAL_NODE },
+  };
+
+  printf("%u events, %zu MiB\n",
+    num_events,
+    (size_t)num_events * sizeof(struct ds_event) >> 20U
+  );
+  printf("%-20s %16s %16s\n", "placement", "events/s", "dTLB miss/event");
+
+  for ( size_t index = 0U; index < sizeof(configurations) / sizeof(*configurations); ++index ) {
+    double num_dispatches;
+    double num_misses;
+
+    if ( !ds_benchmark_tlb_run(num_events, configurations[ index ].flags, &num_dispatches, &num_misses) )
+      return EXIT_FAILURE;
+
+    if ( 0.0 > num_misses ) {
+      printf("%-20s %16.0f %16s\n", configurations[ index ].name, num_dispatches, "n/a");
+    } else {
+      printf("%-20s %16.0f %16.3f\n", configurations[ index ].name, num_dispatches, num_misses);
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+# define DS_BENCHMARK_STATIC_NUM_EVENTS   ( 64U * 1024U )
+# define DS_BENCHMARK_STATIC_SPAN         1024U
+# define DS_BENCHMARK_STATIC_NUM_STEPS    ( 16U * 1024U )
+
+/// the same model on both engines: every event is rescheduled at a random
+/// offset, folding its entity and time into a checksum; both runs draw the
+/// same numbers in the same order, so the checksums have to match
+struct ds_benchmark_static_record {
+  unsigned int                  entity;
+};
+
+static unsigned long long ds_benchmark_static_random;
+static unsigned long long ds_benchmark_static_checksum;
+
+static inline unsigned int ds_benchmark_static_visit (
+  unsigned int                  time,
+  unsigned int                  entity
+)
+{
+  ds_benchmark_static_checksum  = 31ULL * ds_benchmark_static_checksum + ( entity ^ time );
+
+  return time + 1U + ds_benchmark_next(&ds_benchmark_static_random) % DS_BENCHMARK_STATIC_SPAN;
+}
+
+# define DS_BENCHMARK_STATIC_HANDLERS(X)                                      \
+  X(DS_BENCHMARK_STATIC_VISIT,  ds_benchmark_static_handle)
+
+DS_STATIC_DECLARE(ds_benchmark_static,
+  struct ds_benchmark_static_record,
+  unsigned int,
+  DS_BENCHMARK_STATIC_HANDLERS,
+  DS_BENCHMARK_STATIC_NUM_EVENTS,
+  2U * DS_BENCHMARK_STATIC_SPAN
+)
+
+static inline void ds_benchmark_static_handle (
+  struct ds_benchmark_static_simulator * simulator,
+  unsigned int                  time,
+  struct ds_benchmark_static_record * record
+)
+{
+  ds_benchmark_static_schedule(simulator,
+    ds_benchmark_static_visit(time, record->entity),
+    DS_BENCHMARK_STATIC_VISIT,
+    *record
+  );
+}
+
+DS_STATIC_DEFINE(ds_benchmark_static, DS_BENCHMARK_STATIC_HANDLERS)
+
+static void ds_benchmark_static_handle_batch (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    ds_simulator_schedule(simulator,
+      ds_benchmark_static_visit(time, (unsigned int)(uintptr_t)data[ index ]),
+      type,
+      data[ index ]
+    );
+  }
+}
+
+static double ds_benchmark_static_seconds (
+  struct timespec *             begin,
+  struct timespec *             end
+)
+{
+  return (double)( end->tv_sec - begin->tv_sec )
+    + 1e-9 * (double)( end->tv_nsec - begin->tv_nsec );
+}
+
+static int ds_benchmark_static (void)
+{
+  struct ds_simulator simulator;
+
+  /// a batch is rescheduled before being recycled
+  bool is_okay  = ds_simulator_initialize(&simulator,
+    DS_BENCHMARK_STATIC_NUM_EVENTS + DS_EVENT_BATCH_SIZE,
+    2U * DS_BENCHMARK_STATIC_SPAN,
+    1U,
+    DS_MEMORY_DEFAULT
+  );
+
+  if ( !is_okay )
+    return EXIT_FAILURE;
+
+  ds_event_queue_set_adaptive(&simulator.queue, true);
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_benchmark_static_handle_batch);
+
+  ds_benchmark_static_random    = DS_BENCHMARK_SEED;
+  ds_benchmark_static_checksum  = 0ULL;
+
+  for ( unsigned int entity = 0U; entity < DS_BENCHMARK_STATIC_NUM_EVENTS; ++entity ) {
+    ds_simulator_schedule(&simulator,
+      ds_benchmark_next(&ds_benchmark_static_random) % DS_BENCHMARK_STATIC_SPAN,
+      DS_EVENT_TYPE_CUSTOM,
+      (void *)(uintptr_t)entity
+    );
+  }
+
+  struct timespec     begin;
+  struct timespec     end;
+  unsigned long long  num_library_events  = 0ULL;
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+
+  for ( unsigned int step = 0U; step < DS_BENCHMARK_STATIC_NUM_STEPS; ++step ) {
+    num_library_events += ds_simulator_simulate(&simulator);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double              library_seconds   = ds_benchmark_static_seconds(&begin, &end);
+  unsigned long long  library_checksum  = ds_benchmark_static_checksum;
+
+  ds_simulator_drain(&simulator);
+  ds_simulator_deinitialize(&simulator);
+
+  /// too large for the stack
+  static struct ds_benchmark_static_simulator specialized;
+
+  if ( !ds_benchmark_static_initialize(&specialized, 1U) )
+    return EXIT_FAILURE;
+
+  ds_benchmark_static_random    = DS_BENCHMARK_SEED;
+  ds_benchmark_static_checksum  = 0ULL;
+
+  for ( unsigned int entity = 0U; entity < DS_BENCHMARK_STATIC_NUM_EVENTS; ++entity ) {
+    struct ds_benchmark_static_record record  = { .entity = entity };
+
+    ds_benchmark_static_schedule(&specialized,
+      ds_benchmark_next(&ds_benchmark_static_random) % DS_BENCHMARK_STATIC_SPAN,
+      DS_BENCHMARK_STATIC_VISIT,
+      record
+    );
+  }
+
+  unsigned long long  num_static_events = 0ULL;
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+
+  for ( unsigned int step = 0U; step < DS_BENCHMARK_STATIC_NUM_STEPS; ++step ) {
+    num_static_events += ds_benchmark_static_simulate(&specialized);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double  static_seconds  = ds_benchmark_static_seconds(&begin, &end);
+
+  printf("%u events, %u steps\n", DS_BENCHMARK_STATIC_NUM_EVENTS, DS_BENCHMARK_STATIC_NUM_STEPS);
+  printf("%-12s %16s %16s\n", "engine", "events/s", "checksum");
+  printf("%-12s %16.0f %16llx\n", "library",
+    (double)num_library_events / library_seconds,
+    library_checksum
+  );
+  printf("%-12s %16.0f %16llx\n", "static",
+    (double)num_static_events / static_seconds,
+    ds_benchmark_static_checksum
+  );
+
+  if ( num_library_events != num_static_events || library_checksum != ds_benchmark_static_checksum ) {
+    fprintf(stderr, "The engines have diverged.\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+# define DS_BENCHMARK_PIPELINE_NUM_EVENTS ( 1024U * 1024U )
+# define DS_BENCHMARK_PIPELINE_SPAN       64U
+# define DS_BENCHMARK_PIPELINE_TIME_STEP  8U
+# define DS_BENCHMARK_PIPELINE_NUM_STEPS  64U
+# define DS_BENCHMARK_PIPELINE_DEPTH      16U
+
+/// one cache line per entity, far more than the caches hold: dispatching an
+/// event misses on its entity, which the pipeline prefetches ahead
+struct ds_benchmark_pipeline_entity {
+  _Alignas(64) unsigned long long num_visits;
+  unsigned long long            last_time;
+};
+
+/// entities are rescheduled within the step as often as not, so that the
+/// handlers keep scheduling ahead of prepared events
+static unsigned long long ds_benchmark_pipeline_random;
+static unsigned long long ds_benchmark_pipeline_checksum;
+
+static void ds_benchmark_pipeline_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    struct ds_benchmark_pipeline_entity * entity = (struct ds_benchmark_pipeline_entity *)data[ index ];
+
+    ++entity->num_visits;
+    entity->last_time = time;
+
+    ds_benchmark_pipeline_checksum  = 31ULL * ds_benchmark_pipeline_checksum
+      + ( (uintptr_t)entity ^ time );
+
+    ds_simulator_schedule(simulator,
+      time + 1U + ds_benchmark_next(&ds_benchmark_pipeline_random) % DS_BENCHMARK_PIPELINE_SPAN,
+      type,
+      data[ index ]
+    );
+  }
+}
+
+/// `depth` of 0 runs ds_simulator_simulate()
+static bool ds_benchmark_pipeline_run (
+  struct ds_benchmark_pipeline_entity * entities,
+  unsigned int                  num_events,
+  unsigned int                  depth,
+  bool                          is_split,
+  double *                      num_dispatches,
+  double *                      num_requeues,
+  unsigned long long *          checksum
+)
+{
+  struct ds_simulator simulator;
+  struct ds_pipeline  pipeline;
+
+  /// a batch is rescheduled before being recycled
+  bool is_okay  = ds_simulator_initialize(&simulator,
+    num_events + DS_EVENT_BATCH_SIZE,
+    2U * DS_BENCHMARK_PIPELINE_SPAN,
+    DS_BENCHMARK_PIPELINE_TIME_STEP,
+    DS_MEMORY_DEFAULT
+  );
+
+  if ( !is_okay )
+    return false;
+
+  if ( 0U < depth && !ds_pipeline_initialize(&pipeline, depth, is_split) ) {
+    ds_simulator_deinitialize(&simulator);
+    return false;
+  }
+
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_benchmark_pipeline_handle);
+
+  ds_benchmark_pipeline_random    = DS_BENCHMARK_SEED;
+  ds_benchmark_pipeline_checksum  = 0ULL;
+
+  /// entities are scheduled out of memory order
+  for ( unsigned int index = 0U; index < num_events; ++index ) {
+    ds_simulator_schedule(&simulator,
+      ds_benchmark_next(&ds_benchmark_pipeline_random) % DS_BENCHMARK_PIPELINE_SPAN,
+      DS_EVENT_TYPE_CUSTOM,
+      entities + ds_benchmark_next(&ds_benchmark_pipeline_random) % num_events
+    );
+  }
+
+  struct timespec     begin;
+  struct timespec     end;
+  unsigned long long  num_events_processed  = 0ULL;
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+
+  for ( unsigned int step = 0U; step < DS_BENCHMARK_PIPELINE_NUM_STEPS; ++step ) {
+    num_events_processed += 0U == depth ? ds_simulator_simulate(&simulator)
+      : ds_simulator_simulate_pipelined(&simulator, &pipeline);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double seconds  = (double)( end.tv_sec - begin.tv_sec )
+    + 1e-9 * (double)( end.tv_nsec - begin.tv_nsec );
+
+  *num_dispatches = (double)num_events_processed / seconds;
+  *num_requeues   = 0U == depth ? 0.0
+    : (double)pipeline.num_requeues / (double)num_events_processed;
+  *checksum       = ds_benchmark_pipeline_checksum;
+
+  if ( 0U < depth ) {
+    ds_pipeline_deinitialize(&pipeline);
+  }
+
+  ds_simulator_drain(&simulator);
+  ds_simulator_deinitialize(&simulator);
+
+  return true;
+}
+
+static int ds_benchmark_pipeline (
+  unsigned int                  num_events
+)
+{
+  static struct {
+    char const *                name;
+    unsigned int                depth;
+    bool                        is_split;
+  } const configurations [] = {
+    { "sequential",           0U,                             false },
+    { "interleaved",          DS_BENCHMARK_PIPELINE_DEPTH,    false },
+    { "split",                DS_BENCHMARK_PIPELINE_DEPTH,    true },
+  };
+
+  struct ds_benchmark_pipeline_entity * entities
+    = (struct ds_benchmark_pipeline_entity *)calloc(num_events, sizeof(*entities));
+
+  if ( 0U == num_events || NULL == (void *)entities ) {
+    free(entities);
+    return EXIT_FAILURE;
+  }
+
+  int                 exit_code       = EXIT_SUCCESS;
+  unsigned long long  reference       = 0ULL;
+  double              num_sequential  = 0.0;
+  long                num_processors  = sysconf(_SC_NPROCESSORS_ONLN);
+
+  printf("%u events, %u steps of %u, depth %u\n",
+    num_events,
+    DS_BENCHMARK_PIPELINE_NUM_STEPS,
+    DS_BENCHMARK_PIPELINE_TIME_STEP,
+    DS_BENCHMARK_PIPELINE_DEPTH
+  );
+  printf("%-12s %16s %16s %16s\n", "mode", "events/s", "requeues/event", "checksum");
+
+  for ( size_t index = 0U; index < sizeof(configurations) / sizeof(*configurations); ++index ) {
+    double              num_dispatches;
+    double              num_requeues;
+    unsigned long long  checksum;
+
+    bool is_okay  = ds_benchmark_pipeline_run(entities,
+      num_events,
+      configurations[ index ].depth,
+      configurations[ index ].is_split,
+      &num_dispatches,
+      &num_requeues,
+      &checksum
+    );
+
+    if ( !is_okay ) {
+      exit_code = EXIT_FAILURE;
+      break;
+    }
+
+    printf("%-12s %16.0f %16.3f %16llx\n",
+      configurations[ index ].name,
+      num_dispatches,
+      num_requeues,
+      checksum
+    );
+
+    /// every mode has to dispatch in the same order
+    if ( 0U == index ) {
+      reference = checksum;
+    } else if ( reference != checksum ) {
+      fprintf(stderr, "The dispatch orders have diverged.\n");
+      exit_code = EXIT_FAILURE;
+      break;
+    }
+
+    num_sequential  = 0U == configurations[ index ].depth ? num_dispatches : num_sequential;
+
+    /// preparing on a core of its own has to pay for the handoff
+    if ( configurations[ index ].is_split && 1L < num_processors
+      && num_dispatches < num_sequential ) {
+      fprintf(stderr, "The split pipeline is slower than the sequential loop.\n");
+      exit_code = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  if ( EXIT_SUCCESS == exit_code && num_processors <= 1L ) {
+    printf("split not compared: %ld processor\n", num_processors);
+  }
+
+  free(entities);
+
+  return exit_code;
+}
+
+# define DS_BENCHMARK_MMC_NUM_CUSTOMERS   ( 1000U * 1000U )
+# define DS_BENCHMARK_MMC_NUM_SERVERS     4U
+# define DS_BENCHMARK_MMC_NUM_STATIONS    2U
+# define DS_BENCHMARK_MMC_LOAD           0.8
+/// mean, in time units: fine enough for the rounding not to matter
+# define DS_BENCHMARK_MMC_SERVICE_TIME   1000.0
+# define DS_BENCHMARK_MMC_MAX_CUSTOMERS  ( 64U * 1024U )
+# define DS_BENCHMARK_MMC_TIME_STEP      1024U
+
+struct ds_benchmark_mmc_customer {
+  struct ds_benchmark_mmc_customer * next;
+  unsigned int                  arrival_time;
+  unsigned int                  station;
+  bool                          is_served;
+};
+
+/// Poisson arrivals to a tandem of `DS_BENCHMARK_MMC_NUM_STATIONS` stations,
+/// each of `DS_BENCHMARK_MMC_NUM_SERVERS` exponential servers sharing one
+/// FIFO line; an event of the model itself is an arrival, an event of a
+/// customer is its service starting, then ending at its current station
+struct ds_benchmark_mmc {
+  struct ds_resource            servers [ DS_BENCHMARK_MMC_NUM_STATIONS ];
+  struct ds_random              arrivals;
+  struct ds_random              services;
+  struct ds_benchmark_mmc_customer * customers;
+  struct ds_benchmark_mmc_customer * free_customer;
+  unsigned int                  num_customers;
+  unsigned int                  num_arrivals;
+  unsigned int                  num_departures;
+  unsigned long long            response_time;
+  bool                          is_okay;
+};
+
+/// batch handlers have no context of their own
+static struct ds_benchmark_mmc ds_benchmark_mmc_model;
+
+static unsigned int ds_benchmark_mmc_draw (
+  struct ds_random *            random,
+  double                        mean
+)
+{
+  return (unsigned int)( ds_random_exponential(random, mean) + 0.5 );
+}
+
+static void ds_benchmark_mmc_arrive (
+  struct ds_simulator *         simulator,
+  struct ds_benchmark_mmc *     model,
+  unsigned int                  time
+)
+{
+  struct ds_benchmark_mmc_customer * customer = model->free_customer;
+
+  if ( NULL == (void *)customer ) {
+    model->is_okay  = false;
+    return;
+  }
+
+  model->free_customer    = customer->next;
+  customer->next          = (struct ds_benchmark_mmc_customer *)NULL;
+  customer->arrival_time  = time;
+  customer->station       = 0U;
+  customer->is_served     = false;
+
+  model->is_okay  = ds_resource_request(model->servers, time, DS_EVENT_TYPE_CUSTOM, customer)
+    && model->is_okay;
+
+  if ( ++model->num_arrivals < model->num_customers ) {
+    double interarrival = DS_BENCHMARK_MMC_SERVICE_TIME
+      / ( DS_BENCHMARK_MMC_LOAD * DS_BENCHMARK_MMC_NUM_SERVERS );
+
+    model->is_okay  = ds_simulator_schedule(simulator,
+      time + ds_benchmark_mmc_draw(&model->arrivals, interarrival),
+      DS_EVENT_TYPE_CUSTOM,
+      model
+    ) && model->is_okay;
+  }
+}
+
+static void ds_benchmark_mmc_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  struct ds_benchmark_mmc * model = &ds_benchmark_mmc_model;
+
+  (void)type;
+
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    struct ds_benchmark_mmc_customer * customer = (struct ds_benchmark_mmc_customer *)data[ index ];
+
+    if ( (void *)model == data[ index ] ) {
+      ds_benchmark_mmc_arrive(simulator, model, time);
+      continue;
+    }
+
+    if ( !customer->is_served ) {
+      customer->is_served = true;
+
+      model->is_okay  = ds_simulator_schedule(simulator,
+        time + ds_benchmark_mmc_draw(&model->services, DS_BENCHMARK_MMC_SERVICE_TIME),
+        DS_EVENT_TYPE_CUSTOM,
+        customer
+      ) && model->is_okay;
+      continue;
+    }
+
+    model->is_okay  = ds_resource_release(model->servers + customer->station, time)
+      && model->is_okay;
+
+    /// Burke: the departures of a station are Poisson arrivals to the next
+    if ( ++customer->station < DS_BENCHMARK_MMC_NUM_STATIONS ) {
+      customer->is_served = false;
+
+      model->is_okay  = ds_resource_request(model->servers + customer->station,
+        time,
+        DS_EVENT_TYPE_CUSTOM,
+        customer
+      ) && model->is_okay;
+      continue;
+    }
+
+    model->response_time   += time - customer->arrival_time;
+    ++model->num_departures;
+
+    customer->next        = model->free_customer;
+    model->free_customer  = customer;
+  }
+}
+
+/// probability of waiting in an M/M/c queue with offered load `load`, by the
+/// Erlang C formula
+static double ds_benchmark_mmc_erlang (
+  unsigned int                  num_servers,
+  double                        load
+)
+{
+  double offered = load * num_servers;
+  double term    = 1.0;
+  double sum     = 0.0;
+
+  for ( unsigned int k = 0U; k < num_servers; ++k ) {
+    sum  += term;
+    term *= offered / (double)( k + 1U );
+  }
+
+  double tail = term / ( 1.0 - load );
+
+  return tail / ( sum + tail );
+}
+
+static int ds_benchmark_mmc (
+  unsigned int                  num_customers
+)
+{
+  struct ds_simulator       simulator;
+  struct ds_benchmark_mmc * model = &ds_benchmark_mmc_model;
+
+  if ( 0U == num_customers )
+    return EXIT_FAILURE;
+
+  /// a customer holds one event at a time, waiting or not; the arrivals one
+  bool is_okay  = ds_simulator_initialize(&simulator,
+    DS_BENCHMARK_MMC_MAX_CUSTOMERS + 1U + DS_EVENT_BATCH_SIZE,
+    256U,
+    DS_BENCHMARK_MMC_TIME_STEP,
+    DS_MEMORY_DEFAULT
+  );
+
+  if ( !is_okay )
+    return EXIT_FAILURE;
+
+  model->customers  = (struct ds_benchmark_mmc_customer *)calloc(DS_BENCHMARK_MMC_MAX_CUSTOMERS,
+    sizeof(*model->customers)
+  );
+
+  unsigned int  num_stations  = 0U;
+
+  while ( NULL != (void *)model->customers
+    && num_stations < DS_BENCHMARK_MMC_NUM_STATIONS
+    && ds_resource_initialize(model->servers + num_stations,
+      &simulator,
+      DS_BENCHMARK_MMC_NUM_SERVERS
+    ) ) {
+    ++num_stations;
+  }
+
+  if ( num_stations < DS_BENCHMARK_MMC_NUM_STATIONS ) {
+    while ( 0U < num_stations ) {
+      ds_resource_deinitialize(model->servers + --num_stations);
+    }
+
+    free(model->customers);
+    ds_simulator_deinitialize(&simulator);
+    return EXIT_FAILURE;
+  }
+
+  model->free_customer  = (struct ds_benchmark_mmc_customer *)NULL;
+
+  for ( unsigned int index = DS_BENCHMARK_MMC_MAX_CUSTOMERS; 0U < index; --index ) {
+    model->customers[ index - 1U ].next = model->free_customer;
+    model->free_customer                = model->customers + index - 1U;
+  }
+
+  ds_simulator_open_random(&simulator, &model->arrivals, 0U);
+  ds_simulator_open_random(&simulator, &model->services, 1U);
+  model->num_customers  = num_customers;
+  model->num_arrivals   = 0U;
+  model->num_departures = 0U;
+  model->response_time  = 0ULL;
+  model->is_okay        = true;
+
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_benchmark_mmc_handle);
+  ds_simulator_schedule(&simulator, 0U, DS_EVENT_TYPE_CUSTOM, model);
+
+  struct timespec     begin;
+  struct timespec     end;
+  unsigned long long  num_events  = 0ULL;
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+
+  while ( model->is_okay && !ds_simulator_is_empty(&simulator) ) {
+    num_events += ds_simulator_simulate(&simulator);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double seconds  = (double)( end.tv_sec - begin.tv_sec )
+    + 1e-9 * (double)( end.tv_nsec - begin.tv_nsec );
+
+  int exit_code = model->is_okay && num_customers == model->num_departures
+    ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  if ( EXIT_SUCCESS == exit_code ) {
+    double probability  = ds_benchmark_mmc_erlang(DS_BENCHMARK_MMC_NUM_SERVERS, DS_BENCHMARK_MMC_LOAD);
+    double wait_time    = probability * DS_BENCHMARK_MMC_SERVICE_TIME
+      / ( DS_BENCHMARK_MMC_NUM_SERVERS * ( 1.0 - DS_BENCHMARK_MMC_LOAD ) );
+
+    printf("%u x M/M/%u in tandem, load %.2f, %u customers, %llu events in %.3f s (%.0f events/s)\n",
+      DS_BENCHMARK_MMC_NUM_STATIONS,
+      DS_BENCHMARK_MMC_NUM_SERVERS,
+      DS_BENCHMARK_MMC_LOAD,
+      num_customers,
+      num_events,
+      seconds,
+      (double)num_events / seconds
+    );
+    printf("%-16s %12s %12s\n", "", "simulated", "Erlang C");
+
+    /// every station of a Jackson network behaves as an M/M/c queue of its own
+    for ( unsigned int station = 0U; station < DS_BENCHMARK_MMC_NUM_STATIONS; ++station ) {
+      struct ds_resource * servers  = model->servers + station;
+
+      printf("%-8s %-7u %12.4f %12.4f\n", "P(wait)", station,
+        (double)servers->num_waits / (double)servers->num_requests,
+        probability
+      );
+      printf("%-8s %-7u %12.2f %12.2f\n", "wait", station,
+        (double)servers->wait_time / (double)servers->num_requests,
+        wait_time
+      );
+    }
+
+    printf("%-16s %12.2f %12.2f\n", "mean response",
+      (double)model->response_time / (double)model->num_departures,
+      DS_BENCHMARK_MMC_NUM_STATIONS * ( wait_time + DS_BENCHMARK_MMC_SERVICE_TIME )
+    );
+  }
+
+  ds_simulator_drain(&simulator);
+
+  for ( unsigned int station = 0U; station < DS_BENCHMARK_MMC_NUM_STATIONS; ++station ) {
+    ds_resource_deinitialize(model->servers + station);
+  }
+
+  ds_simulator_deinitialize(&simulator);
+  free(model->customers);
+
+  return exit_code;
+}
+
+# define DS_BENCHMARK_PROCESS_NUM_PROCESSES   ( 1024U * 1024U )
+# define DS_BENCHMARK_PROCESS_NUM_HOLDS       16U
+# define DS_BENCHMARK_PROCESS_STACK_SIZE      ( 16U * 1024U )
+
+static void ds_benchmark_process_body (
+  struct ds_process *           process,
+  void *                        argument
+)
+{
+  unsigned int period = 1U + (unsigned int)(uintptr_t)argument % 8U;
+
+  for ( unsigned int hold = 0U; hold < DS_BENCHMARK_PROCESS_NUM_HOLDS; ++hold ) {
+    ds_process_hold(process, period);
+  }
+}
+
+# define DS_BENCHMARK_PROCESS_NUM_TRIPS      ( 4U * 1024U * 1024U )
+
+static void ds_benchmark_process_pong (
+  struct ds_process *           process,
+  void *                        argument
+)
+{
+  (void)argument;
+
+  for ( unsigned int trip = 0U; trip < DS_BENCHMARK_PROCESS_NUM_TRIPS; ++trip ) {
+    ds_process_context_switch(&process->context, &process->arena->scheduler);
+  }
+}
+
+/// nanoseconds per context switch alone, ping-ponging between the scheduler
+/// and a process without going through the queue; 0 on failure
+static double ds_benchmark_process_switch (void)
+{
+  struct ds_simulator     simulator;
+  struct ds_process_arena arena;
+
+  if ( !ds_simulator_initialize(&simulator, 1U, 1U, 1U, DS_MEMORY_DEFAULT) )
+    return 0.0;
+
+  if ( !ds_process_arena_initialize(&arena, 1U, DS_BENCHMARK_PROCESS_STACK_SIZE) ) {
+    ds_simulator_deinitialize(&simulator);
+    return 0.0;
+  }
+
+  struct ds_process * process = ds_process_spawn(&arena,
+    &simulator,
+    0U,
+    ds_benchmark_process_pong,
+    NULL
+  );
+
+  double num_nanoseconds  = 0.0;
+
+  if ( NULL != (void *)process ) {
+    struct timespec begin;
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+
+    /// the first switch enters the body, the last one returns from it
+    for ( unsigned int trip = 0U; trip <= DS_BENCHMARK_PROCESS_NUM_TRIPS; ++trip ) {
+      ds_process_context_switch(&arena.scheduler, &process->context);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds  = (double)( end.tv_sec - begin.tv_sec )
+      + 1e-9 * (double)( end.tv_nsec - begin.tv_nsec );
+
+    num_nanoseconds = 1e9 * seconds / ( 2.0 * ( DS_BENCHMARK_PROCESS_NUM_TRIPS + 1U ) );
+  }
+
+  /// the spawn event is dropped, never resuming the process
+  ds_simulator_drain(&simulator);
+  ds_process_arena_deinitialize(&arena);
+  ds_simulator_deinitialize(&simulator);
+
+  return num_nanoseconds;
+}
+
+/// every process holds a few times: each resume is a dequeue, two context
+/// switches and a schedule, reported next to a bare switch
+static int ds_benchmark_process (
+  unsigned int                  num_processes
+)
+{
+  struct ds_simulator     simulator;
+  struct ds_process_arena arena;
+
+  /// a process reschedules itself before its event is recycled
+  if ( !ds_simulator_initialize(&simulator, num_processes + 1U, 64U, 1U, DS_MEMORY_DEFAULT) )
+    return EXIT_FAILURE;
+
+  if ( !ds_process_arena_initialize(&arena, num_processes, DS_BENCHMARK_PROCESS_STACK_SIZE) ) {
+    ds_simulator_deinitialize(&simulator);
+    return EXIT_FAILURE;
+  }
+
+  int exit_code = EXIT_SUCCESS;
+
+  for ( unsigned int index = 0U; index < num_processes; ++index ) {
+    struct ds_process * process = ds_process_spawn(&arena,
+      &simulator,
+      0U,
+      ds_benchmark_process_body,
+      (void *)(uintptr_t)index
+    );
+
+    if ( NULL == (void *)process ) {
+      exit_code = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  struct timespec     begin;
+  struct timespec     end;
+  unsigned long long  num_resumes = 0ULL;
+
+  clock_gettime(CLOCK_MONOTONIC, &begin);
+
+  while ( EXIT_SUCCESS == exit_code && !ds_simulator_is_empty(&simulator) ) {
+    num_resumes += ds_simulator_simulate(&simulator);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double seconds  = (double)( end.tv_sec - begin.tv_sec )
+    + 1e-9 * (double)( end.tv_nsec - begin.tv_nsec );
+
+  ds_simulator_drain(&simulator);
+  ds_process_arena_deinitialize(&arena);
+  ds_simulator_deinitialize(&simulator);
+
+  double num_nanoseconds  = EXIT_SUCCESS == exit_code ? ds_benchmark_process_switch() : 0.0;
+
+  if ( 0.0 == num_nanoseconds ) {
+    exit_code = EXIT_FAILURE;
+  }
+
+  if ( EXIT_SUCCESS == exit_code ) {
+    printf("%u processes, %llu resumes, %.1f ns/resume, %.1f ns/switch\n",
+      num_processes,
+      num_resumes,
+      1e9 * seconds / (double)num_resumes,
+      num_nanoseconds
+    );
+  }
+
+  return exit_code;
+}
+
+# define DS_TEST_SKIPLIST_NUM_PRODUCERS  4U
+# define DS_TEST_SKIPLIST_NUM_CONSUMERS  2U
+# define DS_TEST_SKIPLIST_NUM_EVENTS     ( 16U * 1024U )
+# define DS_TEST_SKIPLIST_SPAN           64U
+
+/// room for all the events: a thread preempted in an operation holds back
+/// the reclamation, then the nodes pile up in the retired lists
+# define DS_TEST_SKIPLIST_MAX_EVENTS                                          \
+  ( DS_TEST_SKIPLIST_NUM_PRODUCERS * DS_TEST_SKIPLIST_NUM_EVENTS )
+
+/// producers schedule after the horizon they announced, consumers dequeue up
+/// to the horizon and only move it past the announced ones: every consumer
+/// must then see non-decreasing times, each producer's events of a timestamp
+/// in its order, and every event exactly once
+struct ds_test_skiplist {
+  struct ds_event_skiplist      list;
+  _Atomic unsigned int          horizon;
+  _Atomic unsigned int          announced [ DS_TEST_SKIPLIST_NUM_PRODUCERS ];
+  _Atomic unsigned int          num_dequeued;
+  _Atomic unsigned int          num_errors;
+  _Atomic unsigned char         is_seen [ DS_TEST_SKIPLIST_NUM_PRODUCERS ][ DS_TEST_SKIPLIST_NUM_EVENTS ];
+};
+
+static struct ds_test_skiplist ds_test_skiplist_state;
+
+static void * ds_test_skiplist_produce (
+  void *                        argument
+)
+{
+  struct ds_test_skiplist *         test      = &ds_test_skiplist_state;
+  uintptr_t                         producer  = (uintptr_t)argument;
+  struct ds_event_skiplist_thread * thread    = ds_event_skiplist_attach(&test->list);
+  unsigned long long                random    = DS_BENCHMARK_SEED * ( producer + 1U );
+
+  if ( NULL == (void *)thread ) {
+    atomic_fetch_add(&test->num_errors, 1U);
+    return NULL;
+  }
+
+  for ( uintptr_t index = 0U; index < DS_TEST_SKIPLIST_NUM_EVENTS; ++index ) {
+    unsigned int horizon;
+
+    /// the horizon may have moved before the announcement
+    do {
+      horizon = atomic_load(&test->horizon);
+      atomic_store(&test->announced[ producer ], horizon);
+    } while ( horizon != atomic_load(&test->horizon) );
+
+    unsigned int time = horizon + 1U + ds_benchmark_next(&random) % DS_TEST_SKIPLIST_SPAN;
+
+    if ( !ds_event_skiplist_enqueue(thread,
+      time,
+      DS_EVENT_TYPE_CUSTOM,
+      (void *)( ( producer << 32U ) | index )
+    ) ) {
+      atomic_fetch_add(&test->num_errors, 1U);
+      atomic_fetch_add(&test->num_dequeued, 1U);
+    }
+
+    /// the horizon is only held back while enqueuing
+    atomic_store(&test->announced[ producer ], UINT_MAX);
+  }
+
+  ds_event_skiplist_detach(thread);
+
+  return NULL;
+}
+
+static void * ds_test_skiplist_consume (
+  void *                        argument
+)
+{
+  struct ds_test_skiplist *         test    = &ds_test_skiplist_state;
+  struct ds_event_skiplist_thread * thread  = ds_event_skiplist_attach(&test->list);
+  unsigned int                      total   = DS_TEST_SKIPLIST_NUM_PRODUCERS * DS_TEST_SKIPLIST_NUM_EVENTS;
+  unsigned int                      times [ DS_TEST_SKIPLIST_NUM_PRODUCERS ];
+  unsigned int                      indices [ DS_TEST_SKIPLIST_NUM_PRODUCERS ];
+  unsigned int                      last_time = 0U;
+  struct ds_event                   event;
+
+  (void)argument;
+
+  if ( NULL == (void *)thread ) {
+    atomic_fetch_add(&test->num_errors, 1U);
+    return NULL;
+  }
+
+  for ( unsigned int producer = 0U; producer < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++producer ) {
+    times[ producer ]   = 0U;
+    indices[ producer ] = 0U;
+  }
+
+  while ( atomic_load(&test->num_dequeued) < total ) {
+    unsigned int horizon  = atomic_load(&test->horizon);
+
+    if ( NULL == (void *)ds_event_skiplist_dequeue(thread, horizon + 1U, &event) ) {
+      bool is_behind  = false;
+
+      for ( unsigned int producer = 0U; producer < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++producer ) {
+        is_behind = is_behind || atomic_load(&test->announced[ producer ]) <= horizon;
+      }
+
+      if ( is_behind ) {
+        sched_yield();
+      } else {
+        atomic_compare_exchange_strong(&test->horizon, &horizon, horizon + 1U);
+      }
+
+      continue;
+    }
+
+    atomic_fetch_add(&test->num_dequeued, 1U);
+
+    unsigned int producer = (unsigned int)( (uintptr_t)event.data >> 32U );
+    unsigned int index    = (unsigned int)(uintptr_t)event.data;
+    bool         is_okay  = producer < DS_TEST_SKIPLIST_NUM_PRODUCERS
+      && index < DS_TEST_SKIPLIST_NUM_EVENTS
+      && last_time <= event.time && event.time <= horizon
+      && ( times[ producer ] != event.time || indices[ producer ] < index )
+      && 0U == atomic_exchange(&test->is_seen[ producer ][ index ], 1U);
+
+    if ( !is_okay ) {
+      atomic_fetch_add(&test->num_errors, 1U);
+      continue;
+    }
+
+    last_time           = event.time;
+    times[ producer ]   = event.time;
+    indices[ producer ] = index;
+  }
+
+  ds_event_skiplist_detach(thread);
+
+  return NULL;
+}
+
+static bool ds_test_skiplist_capacity (void)
+{
+  struct ds_event_skiplist_thread * thread  = ds_event_skiplist_attach(&ds_test_skiplist_state.list);
+  unsigned int                      num_events;
+  struct ds_event                   event;
+
+  if ( NULL == (void *)thread )
+    return false;
+
+  /// from a single thread, the full capacity is available after a drain
+  bool is_okay  = true;
+
+  for ( unsigned int round = 0U; round < 2U; ++round ) {
+    for ( num_events = 0U; num_events < DS_TEST_SKIPLIST_MAX_EVENTS; ++num_events ) {
+      is_okay = is_okay && ds_event_skiplist_enqueue(thread,
+        round * DS_TEST_SKIPLIST_MAX_EVENTS + num_events,
+        DS_EVENT_TYPE_CUSTOM,
+        NULL
+      );
+    }
+
+    while ( NULL != (void *)ds_event_skiplist_dequeue(thread, UINT_MAX, &event) ) {
+      --num_events;
+    }
+
+    is_okay = is_okay && 0U == num_events;
+  }
+
+  ds_event_skiplist_detach(thread);
+
+  return is_okay;
+}
+
+static int ds_test_skiplist (void)
+{
+  struct ds_test_skiplist * test  = &ds_test_skiplist_state;
+
+  if ( !ds_event_skiplist_initialize(&test->list, DS_TEST_SKIPLIST_MAX_EVENTS) )
+    return EXIT_FAILURE;
+
+  bool is_full  = ds_test_skiplist_capacity();
+
+  atomic_store(&test->horizon, 0U);
+  atomic_store(&test->num_dequeued, 0U);
+  atomic_store(&test->num_errors, 0U);
+
+  for ( unsigned int producer = 0U; producer < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++producer ) {
+    atomic_store(&test->announced[ producer ], UINT_MAX);
+  }
+
+  pthread_t producers [ DS_TEST_SKIPLIST_NUM_PRODUCERS ];
+  pthread_t consumers [ DS_TEST_SKIPLIST_NUM_CONSUMERS ];
+
+  for ( uintptr_t index = 0U; index < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++index ) {
+    pthread_create(producers + index, NULL, ds_test_skiplist_produce, (void *)index);
+  }
+
+  for ( unsigned int index = 0U; index < DS_TEST_SKIPLIST_NUM_CONSUMERS; ++index ) {
+    pthread_create(consumers + index, NULL, ds_test_skiplist_consume, NULL);
+  }
+
+  for ( unsigned int index = 0U; index < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++index ) {
+    pthread_join(producers[ index ], NULL);
+  }
+
+  for ( unsigned int index = 0U; index < DS_TEST_SKIPLIST_NUM_CONSUMERS; ++index ) {
+    pthread_join(consumers[ index ], NULL);
+  }
+
+  unsigned int num_missing  = 0U;
+
+  for ( unsigned int producer = 0U; producer < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++producer ) {
+    for ( unsigned int index = 0U; index < DS_TEST_SKIPLIST_NUM_EVENTS; ++index ) {
+      num_missing += 0U == atomic_load(&test->is_seen[ producer ][ index ]);
+    }
+  }
+
+  ds_event_skiplist_deinitialize(&test->list);
+
+  unsigned int num_errors = atomic_load(&test->num_errors);
+
+  printf("skiplist: capacity %s, %u producers, %u consumers, %u events, %u errors, %u missing\n",
+    is_full ? "ok" : "short",
+    DS_TEST_SKIPLIST_NUM_PRODUCERS,
+    DS_TEST_SKIPLIST_NUM_CONSUMERS,
+    DS_TEST_SKIPLIST_NUM_PRODUCERS * DS_TEST_SKIPLIST_NUM_EVENTS,
+    num_errors,
+    num_missing
+  );
+
+  return is_full && 0U == num_errors && 0U == num_missing ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+# define DS_TEST_PIPELINE_NUM_STEPS   256U
+# define DS_TEST_PIPELINE_TIME_STEP   8U
+# define DS_TEST_PIPELINE_SPAN        4U
+# define DS_TEST_PIPELINE_MAX_ENTITIES  1024U
+
+/// entities are rescheduled at most a few units ahead, within the step, so
+/// that the handlers keep scheduling in front of the prepared events, which
+/// have to be requeued; fewer entities than the ring holds leave the queue
+/// itself empty while events are still pending
+struct ds_test_pipeline {
+  unsigned int                  entities [ DS_TEST_PIPELINE_MAX_ENTITIES ];
+  unsigned int                  num_entities;
+  unsigned int                  num_errors;
+  unsigned long long            random;
+  unsigned long long            checksum;
+};
+
+static struct ds_test_pipeline ds_test_pipeline_state;
+
+static void ds_test_pipeline_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  struct ds_test_pipeline * test  = &ds_test_pipeline_state;
+
+  /// the other entities are pending, in the queue or in the ring
+  if ( num_data < test->num_entities && ds_simulator_is_empty(simulator) ) {
+    ++test->num_errors;
+  }
+
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    unsigned int * entity = (unsigned int *)data[ index ];
+
+    test->checksum  = 31ULL * test->checksum + ( *entity ^ time );
+
+    ds_simulator_schedule(simulator,
+      time + ds_benchmark_next(&test->random) % DS_TEST_PIPELINE_SPAN,
+      type,
+      data[ index ]
+    );
+  }
+}
+
+/// `depth` of 0 runs ds_simulator_simulate()
+static bool ds_test_pipeline_run (
+  unsigned int                  num_entities,
+  unsigned int                  depth,
+  bool                          is_split,
+  unsigned long long *          checksum,
+  unsigned long long *          num_requeues
+)
+{
+  struct ds_test_pipeline * test  = &ds_test_pipeline_state;
+  struct ds_simulator       simulator;
+  struct ds_pipeline        pipeline;
+
+  /// a batch is rescheduled before being recycled
+  if ( !ds_simulator_initialize(&simulator,
+    num_entities + DS_EVENT_BATCH_SIZE,
+    2U * DS_TEST_PIPELINE_TIME_STEP,
+    DS_TEST_PIPELINE_TIME_STEP,
+    DS_MEMORY_DEFAULT
+  ) )
+    return false;
+
+  if ( 0U < depth && !ds_pipeline_initialize(&pipeline, depth, is_split) ) {
+    ds_simulator_deinitialize(&simulator);
+    return false;
+  }
+
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_test_pipeline_handle);
+
+  test->num_entities  = num_entities;
+  test->random        = DS_BENCHMARK_SEED;
+  test->checksum      = 0ULL;
+
+  for ( unsigned int index = 0U; index < num_entities; ++index ) {
+    test->entities[ index ] = index;
+    ds_simulator_schedule(&simulator,
+      index % DS_TEST_PIPELINE_TIME_STEP,
+      DS_EVENT_TYPE_CUSTOM,
+      test->entities + index
+    );
+  }
+
+  for ( unsigned int step = 0U; step < DS_TEST_PIPELINE_NUM_STEPS; ++step ) {
+    if ( 0U == depth ) {
+      ds_simulator_simulate(&simulator);
+    } else {
+      ds_simulator_simulate_pipelined(&simulator, &pipeline);
+    }
+  }
+
+  *checksum     = test->checksum;
+  *num_requeues = 0U == depth ? 0ULL : pipeline.num_requeues;
+
+  if ( 0U < depth ) {
+    ds_pipeline_deinitialize(&pipeline);
+  }
+
+  ds_simulator_drain(&simulator);
+  ds_simulator_deinitialize(&simulator);
+
+  return true;
+}
+
+/// every depth, interleaved or split, has to dispatch in the sequential order
+static int ds_test_pipeline (void)
+{
+  static unsigned int const num_entities [] = { 16U, DS_TEST_PIPELINE_MAX_ENTITIES };
+  static unsigned int const depths [] = { 1U, 7U, DS_PIPELINE_MAX_DEPTH };
+
+  unsigned int        num_runs      = 0U;
+  unsigned int        num_diverged  = 0U;
+  unsigned long long  num_requeues  = 0ULL;
+
+  ds_test_pipeline_state.num_errors = 0U;
+
+  for ( size_t entities = 0U; entities < sizeof(num_entities) / sizeof(*num_entities); ++entities ) {
+    unsigned long long reference;
+    unsigned long long ignored;
+
+    if ( !ds_test_pipeline_run(num_entities[ entities ], 0U, false, &reference, &ignored) )
+      return EXIT_FAILURE;
+
+    for ( size_t depth = 0U; depth < sizeof(depths) / sizeof(*depths); ++depth ) {
+      for ( int is_split = 0; is_split < 2; ++is_split ) {
+        unsigned long long checksum;
+        unsigned long long requeues;
+
+        if ( !ds_test_pipeline_run(num_entities[ entities ], depths[ depth ], is_split, &checksum, &requeues) )
+          return EXIT_FAILURE;
+
+        if ( checksum != reference ) {
+          fprintf(stderr, "Diverged: %u entities, depth %u, %s.\n",
+            num_entities[ entities ],
+            depths[ depth ],
+            is_split ? "split" : "interleaved"
+          );
+          ++num_diverged;
+        }
+
+        num_requeues += requeues;
+        ++num_runs;
+      }
+    }
+  }
+
+  unsigned int num_errors = ds_test_pipeline_state.num_errors;
+
+  printf("pipeline: %u runs, %llu requeues, %u diverged, %u errors\n",
+    num_runs,
+    num_requeues,
+    num_diverged,
+    num_errors
+  );
+
+  return 0ULL < num_requeues && 0U == num_diverged && 0U == num_errors ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+# define DS_TEST_TIMELINE_TIME_STEP   16U
+# define DS_TEST_TIMELINE_ECHO        ( 1U << 31U )
+
+/// the skip list producers schedule into the timeline of a simulator while it
+/// simulates; each event is echoed once, one unit later, by its handler
+struct ds_test_timeline {
+  _Atomic unsigned int          num_producing;
+  unsigned int                  times [ DS_TEST_SKIPLIST_NUM_PRODUCERS ];
+  unsigned int                  indices [ DS_TEST_SKIPLIST_NUM_PRODUCERS ];
+  unsigned int                  last_time;
+  unsigned int                  num_events;
+};
+
+static struct ds_test_timeline ds_test_timeline_state;
+
+static void * ds_test_timeline_produce (
+  void *                        argument
+)
+{
+  ds_test_skiplist_produce(argument);
+  atomic_fetch_sub(&ds_test_timeline_state.num_producing, 1U);
+
+  return NULL;
+}
+
+static void ds_test_timeline_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  struct ds_test_skiplist * list  = &ds_test_skiplist_state;
+  struct ds_test_timeline * test  = &ds_test_timeline_state;
+
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    uintptr_t     value     = (uintptr_t)data[ index ];
+    unsigned int  producer  = (unsigned int)( value >> 32U );
+    unsigned int  event     = (unsigned int)value & ~DS_TEST_TIMELINE_ECHO;
+    bool          is_echo   = 0U != ( (unsigned int)value & DS_TEST_TIMELINE_ECHO );
+
+    ++test->num_events;
+
+    bool is_okay  = producer < DS_TEST_SKIPLIST_NUM_PRODUCERS
+      && event < DS_TEST_SKIPLIST_NUM_EVENTS
+      && test->last_time <= time
+      && simulator->time <= time && time < simulator->time + simulator->time_step
+      && ( is_echo || test->times[ producer ] != time || test->indices[ producer ] < event )
+      && (unsigned char)is_echo == atomic_fetch_add(&list->is_seen[ producer ][ event ], 1U);
+
+    if ( !is_okay ) {
+      atomic_fetch_add(&list->num_errors, 1U);
+      continue;
+    }
+
+    test->last_time = time;
+
+    if ( is_echo )
+      continue;
+
+    test->times[ producer ]   = time;
+    test->indices[ producer ] = event;
+
+    if ( !ds_simulator_schedule(simulator, time + 1U, type, (void *)( value | DS_TEST_TIMELINE_ECHO )) ) {
+      atomic_fetch_add(&list->num_errors, 1U);
+    }
+  }
+}
+
+/// without `list`, runs the entities of test-pipeline on the queue
+static bool ds_test_timeline_run (
+  unsigned int                  num_entities,
+  struct ds_event_skiplist *    list,
+  unsigned long long *          checksum
+)
+{
+  struct ds_test_pipeline *         test      = &ds_test_pipeline_state;
+  struct ds_event_skiplist_thread * timeline  = (struct ds_event_skiplist_thread *)NULL;
+  struct ds_simulator               simulator;
+
+  if ( !ds_simulator_initialize(&simulator,
+    num_entities + DS_EVENT_BATCH_SIZE,
+    2U * DS_TEST_PIPELINE_TIME_STEP,
+    DS_TEST_PIPELINE_TIME_STEP,
+    DS_MEMORY_DEFAULT
+  ) )
+    return false;
+
+  if ( NULL != (void *)list ) {
+    timeline  = ds_event_skiplist_attach(list);
+
+    if ( NULL == (void *)timeline || !ds_simulator_set_timeline(&simulator, timeline) ) {
+      ds_simulator_deinitialize(&simulator);
+      return false;
+    }
+  }
+
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_test_pipeline_handle);
+
+  test->num_entities  = num_entities;
+  test->random        = DS_BENCHMARK_SEED;
+  test->checksum      = 0ULL;
+
+  for ( unsigned int index = 0U; index < num_entities; ++index ) {
+    test->entities[ index ] = index;
+    ds_simulator_schedule(&simulator,
+      index % DS_TEST_PIPELINE_TIME_STEP,
+      DS_EVENT_TYPE_CUSTOM,
+      test->entities + index
+    );
+  }
+
+  for ( unsigned int step = 0U; step < DS_TEST_PIPELINE_NUM_STEPS; ++step ) {
+    ds_simulator_simulate(&simulator);
+  }
+
+  *checksum = test->checksum;
+
+  ds_simulator_drain(&simulator);
+
+  if ( NULL != (void *)timeline ) {
+    ds_event_skiplist_detach(timeline);
+  }
+
+  ds_simulator_deinitialize(&simulator);
+
+  return true;
+}
+
+/// the simulator moves the horizon to the end of each step, then waits for
+/// the producers which announced an earlier one before simulating it
+static bool ds_test_timeline_share (void)
+{
+  struct ds_test_skiplist * list  = &ds_test_skiplist_state;
+  struct ds_test_timeline * test  = &ds_test_timeline_state;
+  struct ds_simulator       simulator;
+
+  /// room for the echoes as well
+  if ( !ds_event_skiplist_initialize(&list->list, 2U * DS_TEST_SKIPLIST_MAX_EVENTS) )
+    return false;
+
+  struct ds_event_skiplist_thread * timeline  = ds_event_skiplist_attach(&list->list);
+
+  if ( NULL == (void *)timeline
+    || !ds_simulator_initialize(&simulator,
+      DS_EVENT_BATCH_SIZE,
+      2U * DS_TEST_TIMELINE_TIME_STEP,
+      DS_TEST_TIMELINE_TIME_STEP,
+      DS_MEMORY_DEFAULT
+    ) ) {
+    ds_event_skiplist_deinitialize(&list->list);
+    return false;
+  }
+
+  ds_simulator_set_timeline(&simulator, timeline);
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_test_timeline_handle);
+
+  atomic_store(&list->horizon, 0U);
+
+  for ( unsigned int producer = 0U; producer < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++producer ) {
+    atomic_store(&list->announced[ producer ], UINT_MAX);
+    test->times[ producer ]   = 0U;
+    test->indices[ producer ] = 0U;
+
+    for ( unsigned int index = 0U; index < DS_TEST_SKIPLIST_NUM_EVENTS; ++index ) {
+      atomic_store(&list->is_seen[ producer ][ index ], 0U);
+    }
+  }
+
+  test->last_time   = 0U;
+  test->num_events  = 0U;
+  atomic_store(&test->num_producing, DS_TEST_SKIPLIST_NUM_PRODUCERS);
+
+  pthread_t producers [ DS_TEST_SKIPLIST_NUM_PRODUCERS ];
+
+  for ( uintptr_t index = 0U; index < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++index ) {
+    pthread_create(producers + index, NULL, ds_test_timeline_produce, (void *)index);
+  }
+
+  do {
+    unsigned int horizon  = simulator.time + simulator.time_step - 1U;
+
+    atomic_store(&list->horizon, horizon);
+
+    for ( unsigned int producer = 0U; producer < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++producer ) {
+      while ( atomic_load(&list->announced[ producer ]) < horizon ) {
+        sched_yield();
+      }
+    }
+
+    ds_simulator_simulate(&simulator);
+  } while ( 0U < atomic_load(&test->num_producing) || !ds_simulator_is_empty(&simulator) );
+
+  for ( unsigned int index = 0U; index < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++index ) {
+    pthread_join(producers[ index ], NULL);
+  }
+
+  ds_event_skiplist_detach(timeline);
+  ds_simulator_deinitialize(&simulator);
+  ds_event_skiplist_deinitialize(&list->list);
+
+  return true;
+}
+
+/// the timeline has to dispatch in the order of the queue, and dispatch every
+/// event the other threads schedule into it exactly once, in order
+static int ds_test_timeline (void)
+{
+  static unsigned int const num_entities [] = { 16U, DS_TEST_PIPELINE_MAX_ENTITIES };
+
+  struct ds_test_skiplist * list          = &ds_test_skiplist_state;
+  unsigned int              num_runs      = 0U;
+  unsigned int              num_diverged  = 0U;
+
+  ds_test_pipeline_state.num_errors = 0U;
+  atomic_store(&list->num_errors, 0U);
+
+  for ( size_t entities = 0U; entities < sizeof(num_entities) / sizeof(*num_entities); ++entities ) {
+    unsigned long long reference;
+    unsigned long long checksum;
+
+    if ( !ds_test_timeline_run(num_entities[ entities ], (struct ds_event_skiplist *)NULL, &reference) )
+      return EXIT_FAILURE;
+
+    if ( !ds_event_skiplist_initialize(&list->list, DS_TEST_PIPELINE_MAX_ENTITIES) )
+      return EXIT_FAILURE;
+
+    bool is_okay  = ds_test_timeline_run(num_entities[ entities ], &list->list, &checksum);
+
+    ds_event_skiplist_deinitialize(&list->list);
+
+    if ( !is_okay )
+      return EXIT_FAILURE;
+
+    if ( checksum != reference ) {
+      fprintf(stderr, "Diverged: %u entities.\n", num_entities[ entities ]);
+      ++num_diverged;
+    }
+
+    ++num_runs;
+  }
+
+  if ( !ds_test_timeline_share() )
+    return EXIT_FAILURE;
+
+  unsigned int num_missing  = 0U;
+
+  for ( unsigned int producer = 0U; producer < DS_TEST_SKIPLIST_NUM_PRODUCERS; ++producer ) {
+    for ( unsigned int index = 0U; index < DS_TEST_SKIPLIST_NUM_EVENTS; ++index ) {
+      num_missing += 2U != atomic_load(&list->is_seen[ producer ][ index ]);
+    }
+  }
+
+  unsigned int num_errors = ds_test_pipeline_state.num_errors + atomic_load(&list->num_errors);
+
+  printf("timeline: %u runs, %u diverged, %u producers, %u events, %u errors, %u missing\n",
+    num_runs,
+    num_diverged,
+    DS_TEST_SKIPLIST_NUM_PRODUCERS,
+    ds_test_timeline_state.num_events,
+    num_errors,
+    num_missing
+  );
+
+  return 0U == num_diverged && 0U == num_errors && 0U == num_missing ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+# define DS_TEST_ADAPT_NUM_ENTITIES   2048U
+# define DS_TEST_ADAPT_SPAN           2048U
+# define DS_TEST_ADAPT_TIME_STEP      64U
+# define DS_TEST_ADAPT_WARM_UP        ( 4U * DS_TEST_ADAPT_SPAN )
+# define DS_TEST_ADAPT_DRAIN          ( 16U * DS_TEST_ADAPT_SPAN )
+
+/// one entity grows into `DS_TEST_ADAPT_NUM_ENTITIES` during the warm-up,
+/// which are rescheduled far enough ahead for a list to be slow until the
+/// drain, when one in 64 is dropped at each event: the queue has to move
+/// to a calendar and back to a list, without dispatching in another order
+struct ds_test_adapt {
+  unsigned int                  entities [ DS_TEST_ADAPT_NUM_ENTITIES ];
+  unsigned int                  num_entities;
+  unsigned int                  num_migrations;
+  unsigned int                  num_returns;
+  unsigned int                  num_operations;
+  unsigned int                  num_errors;
+  unsigned long long            random;
+  unsigned long long            checksum;
+};
+
+static struct ds_test_adapt ds_test_adapt_state;
+
+static void ds_test_adapt_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  struct ds_test_adapt * test = &ds_test_adapt_state;
+
+  test->num_operations += num_data;
+
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    unsigned int * entity = (unsigned int *)data[ index ];
+    unsigned int   random = ds_benchmark_next(&test->random);
+
+    test->checksum  = 31ULL * test->checksum + ( *entity ^ time );
+
+    if ( DS_TEST_ADAPT_DRAIN <= time && 0U == random % 64U )
+      continue;
+
+    ds_simulator_schedule(simulator, time + 1U + random % DS_TEST_ADAPT_SPAN, type, entity);
+    ++test->num_operations;
+
+    if ( time < DS_TEST_ADAPT_WARM_UP && test->num_entities < DS_TEST_ADAPT_NUM_ENTITIES ) {
+      ds_simulator_schedule(simulator,
+        time + 1U,
+        type,
+        test->entities + test->num_entities++
+      );
+      ++test->num_operations;
+    }
+
+    /// hysteresis: a migration is amortized over a period at least
+    unsigned int num_migrations = ds_event_queue_get_num_migrations(&simulator->queue);
+
+    if ( num_migrations != test->num_migrations ) {
+      if ( test->num_operations < DS_EVENT_QUEUE_ADAPT_PERIOD ) {
+        ++test->num_errors;
+      }
+
+      if ( DS_EVENT_QUEUE_KIND_LIST == ds_event_queue_get_kind(&simulator->queue) ) {
+        ++test->num_returns;
+      }
+
+      test->num_migrations  = num_migrations;
+      test->num_operations  = 0U;
+    }
+  }
+}
+
+/// runs the model until the queue is empty, from a fresh or a reset simulator
+static void ds_test_adapt_run (
+  struct ds_simulator *         simulator,
+  unsigned long long *          checksum,
+  unsigned int *                num_migrations,
+  unsigned int *                num_returns
+)
+{
+  struct ds_test_adapt * test = &ds_test_adapt_state;
+
+  for ( unsigned int index = 0U; index < DS_TEST_ADAPT_NUM_ENTITIES; ++index ) {
+    test->entities[ index ] = index;
+  }
+
+  test->num_entities    = 1U;
+  test->num_migrations  = ds_event_queue_get_num_migrations(&simulator->queue);
+  test->num_returns     = 0U;
+  test->num_operations  = 0U;
+  test->random          = DS_BENCHMARK_SEED;
+  test->checksum        = 0ULL;
+
+  ds_simulator_schedule(simulator, 0U, DS_EVENT_TYPE_CUSTOM, test->entities);
+
+  while ( !ds_simulator_is_empty(simulator) ) {
+    ds_simulator_simulate(simulator);
+  }
+
+  *checksum       = test->checksum;
+  *num_migrations = ds_event_queue_get_num_migrations(&simulator->queue);
+  *num_returns    = test->num_returns;
+}
+
+/// the same model on a list, on an adaptive queue, then on the adaptive
+/// queue once reset, which has to behave as a fresh one
+static int ds_test_adapt (void)
+{
+  struct ds_simulator simulator [ 2 ];
+  unsigned long long  checksums [ 3 ];
+  unsigned int        num_migrations [ 3 ];
+  unsigned int        num_returns [ 3 ];
+
+  ds_test_adapt_state.num_errors  = 0U;
+
+  for ( unsigned int index = 0U; index < 2U; ++index ) {
+    /// a batch is rescheduled before being recycled
+    if ( !ds_simulator_initialize(simulator + index,
+      2U * DS_TEST_ADAPT_NUM_ENTITIES + DS_EVENT_BATCH_SIZE,
+      2U * DS_TEST_ADAPT_NUM_ENTITIES,
+      DS_TEST_ADAPT_TIME_STEP,
+      DS_MEMORY_DEFAULT
+    ) ) {
+      if ( 1U == index ) {
+        ds_simulator_deinitialize(simulator);
+      }
+      return EXIT_FAILURE;
+    }
+
+    ds_simulator_set_batch_handler(simulator + index, DS_EVENT_TYPE_CUSTOM, ds_test_adapt_handle);
+  }
+
+  bool is_okay  = ds_event_queue_set_adaptive(&simulator[ 1 ].queue, true);
+
+  for ( unsigned int run = 0U; is_okay && run < 3U; ++run ) {
+    struct ds_simulator * current = simulator + ( 0U == run ? 0U : 1U );
+
+    if ( 2U == run ) {
+      ds_simulator_reset(current);
+    }
+
+    ds_test_adapt_run(current, checksums + run, num_migrations + run, num_returns + run);
+  }
+
+  ds_simulator_deinitialize(simulator + 1);
+  ds_simulator_deinitialize(simulator);
+
+  if ( !is_okay )
+    return EXIT_FAILURE;
+
+  unsigned int num_errors = ds_test_adapt_state.num_errors;
+
+  printf("adapt: %u migrations, %u back to a list, %u after a reset, %s order, %u errors\n",
+    num_migrations[ 1 ],
+    num_returns[ 1 ],
+    num_migrations[ 2 ],
+    checksums[ 0 ] == checksums[ 1 ] && checksums[ 1 ] == checksums[ 2 ] ? "same" : "different",
+    num_errors
+  );
+
+  return 0U == num_migrations[ 0 ]
+    && 2U <= num_migrations[ 1 ]
+    && num_migrations[ 1 ] == num_migrations[ 2 ]
+    && 0U < num_returns[ 1 ]
+    && checksums[ 0 ] == checksums[ 1 ]
+    && checksums[ 1 ] == checksums[ 2 ]
+    && 0U == num_errors
+    ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+# define DS_TEST_SPILL_NUM_ENTITIES   1024U
+# define DS_TEST_SPILL_WINDOW         256U
+# define DS_TEST_SPILL_TIME_STEP      16U
+# define DS_TEST_SPILL_SPAN           ( 4U * DS_TEST_SPILL_WINDOW )
+# define DS_TEST_SPILL_END            ( 64U * DS_TEST_SPILL_WINDOW )
+# define DS_TEST_SPILL_MAX_LOG        ( 64U * 1024U )
+# define DS_TEST_SPILL_MAX_BUFFERED   64U
+# define DS_TEST_SPILL_MAX_RUNS       4U
+# define DS_TEST_SPILL_NUM_RECORDS    4096U
+# define DS_TEST_SPILL_MAX_QUEUED     384U
+
+/// entities start and are rescheduled up to several windows ahead, until
+/// `DS_TEST_SPILL_END`: with a small buffer and few runs, spilling them
+/// flushes runs, compacts them and merges them back in the background, and
+/// the dispatches have to be those of the same model kept in memory
+struct ds_test_spill {
+  unsigned int                  entities [ DS_TEST_SPILL_NUM_ENTITIES ];
+  unsigned long long *          log;
+  unsigned int                  num_logged;
+  unsigned long long            random;
+};
+
+static struct ds_test_spill ds_test_spill_state;
+
+static void ds_test_spill_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  struct ds_test_spill * test = &ds_test_spill_state;
+
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    unsigned int * entity = (unsigned int *)data[ index ];
+
+    if ( test->num_logged < DS_TEST_SPILL_MAX_LOG ) {
+      test->log[ test->num_logged ] = (unsigned long long)time << 32U | *entity;
+    }
+
+    ++test->num_logged;
+
+    unsigned int next = time + 1U + ds_benchmark_next(&test->random) % DS_TEST_SPILL_SPAN;
+
+    if ( next < DS_TEST_SPILL_END ) {
+      ds_simulator_schedule(simulator, next, type, entity);
+    }
+  }
+}
+
+/// `spill` of NULL keeps every event in memory; false if the simulator stalls
+static bool ds_test_spill_run (
+  struct ds_spill *             spill,
+  unsigned long long *          log
+)
+{
+  struct ds_test_spill *  test  = &ds_test_spill_state;
+  struct ds_simulator     simulator;
+
+  /// a batch is rescheduled before being recycled
+  if ( !ds_simulator_initialize(&simulator,
+    DS_TEST_SPILL_NUM_ENTITIES + DS_EVENT_BATCH_SIZE,
+    DS_TEST_SPILL_NUM_ENTITIES,
+    DS_TEST_SPILL_TIME_STEP,
+    DS_MEMORY_DEFAULT
+  ) )
+    return false;
+
+  ds_simulator_set_batch_handler(&simulator, DS_EVENT_TYPE_CUSTOM, ds_test_spill_handle);
+  ds_simulator_set_spill(&simulator, spill);
+
+  test->log         = log;
+  test->num_logged  = 0U;
+  test->random      = DS_BENCHMARK_SEED;
+
+  /// most of them past the horizon from the start
+  for ( unsigned int index = 0U; index < DS_TEST_SPILL_NUM_ENTITIES; ++index ) {
+    test->entities[ index ] = index;
+    ds_simulator_schedule(&simulator,
+      ds_benchmark_next(&test->random) % DS_TEST_SPILL_SPAN,
+      DS_EVENT_TYPE_CUSTOM,
+      test->entities + index
+    );
+  }
+
+  bool is_okay  = true;
+
+  while ( is_okay && !ds_simulator_is_empty(&simulator) ) {
+    ds_simulator_simulate(&simulator);
+    is_okay = !simulator.is_stalled;
+  }
+
+  ds_simulator_drain(&simulator);
+  ds_simulator_set_spill(&simulator, (struct ds_spill *)NULL);
+  ds_simulator_deinitialize(&simulator);
+
+  return is_okay;
+}
+
+/// refills a queue too small for a window, which fails midway: emptying the
+/// queue and refilling again has to resume where the merge stopped, neither
+/// losing nor repeating records; returns the number of resumed refills
+static unsigned int ds_test_spill_resume (
+  char const *                  directory,
+  unsigned int *                num_wrong
+)
+{
+  struct ds_spill       spill;
+  struct ds_event_queue queue;
+  unsigned int          times [ DS_TEST_SPILL_NUM_RECORDS ];
+  unsigned int          num_resumes = 0U;
+  unsigned long long    random      = DS_BENCHMARK_SEED;
+
+  *num_wrong  = 1U;
+
+  if ( !ds_spill_initialize(&spill,
+    directory,
+    2U * DS_TEST_SPILL_MAX_QUEUED,
+    DS_TEST_SPILL_MAX_BUFFERED,
+    DS_TEST_SPILL_MAX_RUNS
+  ) )
+    return num_resumes;
+
+  if ( !ds_event_queue_initialize(&queue, DS_TEST_SPILL_MAX_QUEUED, DS_TEST_SPILL_MAX_QUEUED, DS_MEMORY_DEFAULT) ) {
+    ds_spill_deinitialize(&spill);
+    return num_resumes;
+  }
+
+  /// about twice as many records per window as the queue holds
+  for ( unsigned int index = 0U; index < DS_TEST_SPILL_NUM_RECORDS; ++index ) {
+    times[ index ]  = spill.horizon + ds_benchmark_next(&random) % DS_TEST_SPILL_NUM_RECORDS;
+    ds_spill_append(&spill, times[ index ], DS_EVENT_TYPE_CUSTOM, (void *)(uintptr_t)( index + 1U ));
+  }
+
+  unsigned int num_dequeued = 0U;
+  unsigned int time_limit   = spill.horizon;
+  unsigned int end_time     = spill.horizon + DS_TEST_SPILL_NUM_RECORDS;
+  unsigned int last_time    = 0U;
+  unsigned int last_index   = 0U;
+
+  *num_wrong  = 0U;
+
+  while ( !ds_spill_is_empty(&spill) && time_limit < end_time ) {
+    time_limit += spill.window;
+
+    bool is_refilled;
+
+    do {
+      is_refilled = ds_spill_refill(&spill, &queue, time_limit);
+      num_resumes += is_refilled ? 0U : 1U;
+
+      /// sorted by time, then in the order appended
+      for ( struct ds_event * event; NULL != (void *)( event = ds_event_queue_dequeue(&queue, UINT_MAX) ); ) {
+        unsigned int index  = (unsigned int)(uintptr_t)event->data - 1U;
+
+        if ( DS_TEST_SPILL_NUM_RECORDS <= index || times[ index ] != event->time
+          || ( 0U < num_dequeued
+            && ( event->time < last_time || ( event->time == last_time && index <= last_index ) ) ) ) {
+          ++*num_wrong;
+        }
+
+        last_time   = event->time;
+        last_index  = index;
+        ++num_dequeued;
+
+        ds_event_queue_recycle(&queue, event);
+      }
+    } while ( !is_refilled && num_resumes < DS_TEST_SPILL_NUM_RECORDS );
+  }
+
+  *num_wrong += DS_TEST_SPILL_NUM_RECORDS == num_dequeued ? 0U : 1U;
+
+  ds_event_queue_deinitialize(&queue);
+  ds_spill_deinitialize(&spill);
+
+  return num_resumes;
+}
+
+/// the same model in memory and spilled, then the refill of a queue too small
+static int ds_test_spill (void)
+{
+  char const *          directory = NULL == getenv("TMPDIR") ? "/tmp" : getenv("TMPDIR");
+  unsigned long long *  logs      = (unsigned long long *)malloc(
+    2U * DS_TEST_SPILL_MAX_LOG * sizeof(*logs)
+  );
+
+  if ( NULL == (void *)logs )
+    return EXIT_FAILURE;
+
+  struct ds_spill spill;
+
+  if ( !ds_spill_initialize(&spill,
+    directory,
+    DS_TEST_SPILL_WINDOW,
+    DS_TEST_SPILL_MAX_BUFFERED,
+    DS_TEST_SPILL_MAX_RUNS
+  ) ) {
+    free(logs);
+    return EXIT_FAILURE;
+  }
+
+  bool          is_okay         = ds_test_spill_run((struct ds_spill *)NULL, logs);
+  unsigned int  num_reference   = ds_test_spill_state.num_logged;
+
+  is_okay = is_okay && ds_test_spill_run(&spill, logs + DS_TEST_SPILL_MAX_LOG);
+
+  unsigned int  num_spilled     = ds_test_spill_state.num_logged;
+  unsigned int  num_diverged    = num_reference == num_spilled
+    && num_reference <= DS_TEST_SPILL_MAX_LOG ? 0U : 1U;
+
+  for ( unsigned int index = 0U; 0U == num_diverged && index < num_reference; ++index ) {
+    if ( logs[ index ] != logs[ DS_TEST_SPILL_MAX_LOG + index ] ) {
+      fprintf(stderr, "Diverged: dispatch %u is %llu:%llu, expected %llu:%llu.\n",
+        index,
+        logs[ DS_TEST_SPILL_MAX_LOG + index ] >> 32U,
+        logs[ DS_TEST_SPILL_MAX_LOG + index ] & 0xFFFFFFFFULL,
+        logs[ index ] >> 32U,
+        logs[ index ] & 0xFFFFFFFFULL
+      );
+      ++num_diverged;
+    }
+  }
+
+  ds_spill_deinitialize(&spill);
+  free(logs);
+
+  /// the failed refills report their errors on the way
+  unsigned int num_wrong;
+  unsigned int num_resumes  = ds_test_spill_resume(directory, &num_wrong);
+
+  printf("spill: %u dispatches, %u diverged, %s, %u resumed refills, %u wrong\n",
+    num_spilled,
+    num_diverged,
+    is_okay ? "not stalled" : "stalled",
+    num_resumes,
+    num_wrong
+  );
+
+  return is_okay && 0U == num_diverged && 0U < num_resumes && 0U == num_wrong
+    ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+# define DS_TEST_SINK_CAPACITY        256U
+# define DS_TEST_SINK_NUM_EVENTS      ( 8U * 1024U )
+# define DS_TEST_SINK_FLUSH_PERIOD    64U
+# define DS_TEST_SINK_READ_SIZE       4096U
+# define DS_TEST_SINK_MAX_OUTPUT      ( 1024U * 1024U )
+
+/// the sink writes into a small pipe read slowly, so that the pipe fills up,
+/// the owner stalls on both buffers and flushes find a buffer still pending
+struct ds_test_sink {
+  char *                        output;
+  size_t                        num_read;
+  int                           fd;
+};
+
+static struct ds_test_sink ds_test_sink_state;
+
+static void * ds_test_sink_read (
+  void *                        argument
+)
+{
+  struct ds_test_sink * test    = &ds_test_sink_state;
+  struct timespec       pause   = { 0, 100L * 1000L };
+
+  (void)argument;
+
+  while ( true ) {
+    nanosleep(&pause, NULL);
+
+    size_t  free_size = DS_TEST_SINK_MAX_OUTPUT - test->num_read;
+    ssize_t num_bytes = read(test->fd,
+      test->output + test->num_read,
+      free_size < DS_TEST_SINK_READ_SIZE ? free_size : DS_TEST_SINK_READ_SIZE
+    );
+
+    if ( 0 > num_bytes && EINTR == errno )
+      continue;
+
+    if ( 0 >= num_bytes )
+      break;
+
+    test->num_read  += (size_t)num_bytes;
+  }
+
+  return NULL;
+}
+
+/// writes events and messages through a small sink, then compares what came
+/// out of the pipe with the same records formatted directly
+static bool ds_test_sink_run (
+  enum ds_event_format          format,
+  char *                        expected,
+  unsigned long long *          num_stalls,
+  unsigned int *                num_overlaps,
+  bool *                        is_same
+)
+{
+  struct ds_test_sink * test  = &ds_test_sink_state;
+  struct ds_sink        sink;
+  pthread_t             reader;
+  int                   fds [ 2 ];
+
+  if ( 0 != pipe(fds) )
+    return false;
+
+  /// as small as it gets, a page: the writes keep blocking
+  fcntl(fds[ 1 ], F_SETPIPE_SZ, DS_TEST_SINK_READ_SIZE);
+
+  test->fd        = fds[ 0 ];
+  test->num_read  = 0U;
+
+  if ( 0 != pthread_create(&reader, NULL, ds_test_sink_read, NULL) ) {
+    close(fds[ 0 ]);
+    close(fds[ 1 ]);
+    return false;
+  }
+
+  size_t  num_expected  = 0U;
+  bool    is_okay       = ds_sink_initialize(&sink, fds[ 1 ], format, DS_TEST_SINK_CAPACITY);
+
+  if ( is_okay && DS_EVENT_FORMAT_CSV == format ) {
+    num_expected  += (size_t)sprintf(expected, "time,type,data\n");
+  }
+
+  *num_overlaps = 0U;
+
+  for ( unsigned int index = 0U; is_okay && index < DS_TEST_SINK_NUM_EVENTS; ++index ) {
+    struct ds_event event = {
+      .next = (struct ds_event *)NULL,
+      .time = index,
+      .type = (enum ds_event_type)( index % (unsigned int)DS_NUM_EVENT_TYPES ),
+      .data = (void *)(uintptr_t)( index * 64U )
+    };
+
+    is_okay = ds_sink_write_event(&sink, &event);
+    num_expected  += (size_t)ds_event_serialize(&event,
+      format,
+      expected + num_expected,
+      DS_TEST_SINK_MAX_OUTPUT - num_expected
+    );
+
+    if ( 0U == index % 7U ) {
+      is_okay = is_okay && ds_sink_printf(&sink, "# %u\n", index);
+      num_expected  += (size_t)sprintf(expected + num_expected, "# %u\n", index);
+    }
+
+    if ( 0U == ( index + 1U ) % DS_TEST_SINK_FLUSH_PERIOD ) {
+      /// the active buffer goes behind the one being written, if any
+      pthread_mutex_lock(&sink.lock);
+      *num_overlaps  += 0U != sink.num_pending ? 1U : 0U;
+      pthread_mutex_unlock(&sink.lock);
+
+      is_okay = is_okay && ds_sink_flush(&sink);
+    }
+  }
+
+  *num_stalls = sink.num_stalls;
+
+  is_okay = ds_sink_deinitialize(&sink) && is_okay;
+
+  close(fds[ 1 ]);
+  pthread_join(reader, NULL);
+  close(fds[ 0 ]);
+
+  *is_same  = num_expected == test->num_read
+    && 0 == memcmp(expected, test->output, num_expected);
+
+  return is_okay;
+}
+
+/// every format, with backpressure and overlapping flushes
+static int ds_test_sink (void)
+{
+  static char const * const names [] = { "text", "csv", "binary" };
+
+  char *  expected  = (char *)malloc(DS_TEST_SINK_MAX_OUTPUT);
+
+  ds_test_sink_state.output = (char *)malloc(DS_TEST_SINK_MAX_OUTPUT);
+
+  if ( NULL == (void *)expected || NULL == (void *)ds_test_sink_state.output ) {
+    free(ds_test_sink_state.output);
+    free(expected);
+    return EXIT_FAILURE;
+  }
+
+  int exit_code = EXIT_SUCCESS;
+
+  for ( int format = 0; format < (int)DS_NUM_EVENT_FORMATS; ++format ) {
+    unsigned long long  num_stalls;
+    unsigned int        num_overlaps;
+    bool                is_same;
+
+    if ( !ds_test_sink_run((enum ds_event_format)format, expected, &num_stalls, &num_overlaps, &is_same) ) {
+      exit_code = EXIT_FAILURE;
+      break;
+    }
+
+    printf("sink: %-6s %8zu bytes, %s, %llu stalls, %u flushes behind a pending buffer\n",
+      names[ format ],
+      ds_test_sink_state.num_read,
+      is_same ? "same" : "different",
+      num_stalls,
+      num_overlaps
+    );
+
+    if ( !is_same || 0ULL == num_stalls || 0U == num_overlaps ) {
+      exit_code = EXIT_FAILURE;
+    }
+  }
+
+  free(ds_test_sink_state.output);
+  free(expected);
+
+  return exit_code;
+}
+
+# define DS_TEST_RESOURCE_MAX_EVENTS  64U
+# define DS_TEST_RESOURCE_MAX_LOG     32U
+
+/// the data of an event is a tag, an offset into `tags`, except for the
+/// gets of a store, which carry the item put; the handler logs time and tag
+struct ds_test_resource {
+  char                          tags [ DS_TEST_RESOURCE_MAX_EVENTS ];
+  unsigned int                  log [ DS_TEST_RESOURCE_MAX_LOG ][ 2 ];
+  unsigned int                  num_logged;
+};
+
+static struct ds_test_resource ds_test_resource_state;
+
+static void ds_test_resource_handle (
+  struct ds_simulator *         simulator,
+  enum ds_event_type            type,
+  unsigned int                  time,
+  void * const *                data,
+  unsigned int                  num_data
+)
+{
+  struct ds_test_resource * test  = &ds_test_resource_state;
+
+  (void)simulator;
+  (void)type;
+
+  for ( unsigned int index = 0U; index < num_data; ++index ) {
+    if ( DS_TEST_RESOURCE_MAX_LOG <= test->num_logged )
+      return;
+
+    test->log[ test->num_logged ][ 0 ]  = time;
+    test->log[ test->num_logged ][ 1 ]  = (unsigned int)( (char *)data[ index ] - test->tags );
+    ++test->num_logged;
+  }
+}
+
+static unsigned int ds_test_resource_count_free (
+  struct ds_simulator *         simulator
+)
+{
+  unsigned int num_free = 0U;
+
+  for ( struct ds_event * event = simulator->queue.events.free_event;
+        NULL != (void *)event;
+        event = event->next ) {
+    ++num_free;
+  }
+
+  return num_free;
+}
+
+/// a store and a container, one operation after the other, each time unit
+/// simulated before the next: FIFO order, blocked operations unblocking each
+/// other, and the events of the operations still blocked at deinitialization
+/// back in the pool
+static int ds_test_resource (void)
+{
+  static unsigned int const expected [][ 2 ] = {
+    /// a get waiting for the first put, the third put blocked
+    { 0U, 10U }, { 0U, 1U }, { 0U, 2U }, { 0U, 3U },
+    /// a get unblocking it, then items in the order they were put
+    { 1U, 11U }, { 1U, 4U }, { 2U, 12U }, { 2U, 13U },
+    /// a put serving the gets in order, the last put blocked
+    { 3U, 22U }, { 3U, 20U }, { 3U, 21U }, { 3U, 23U },
+    /// a get unblocking it
+    { 4U, 25U }, { 4U, 24U },
+    /// an item stored at deinitialization
+    { 5U, 5U }
+  };
+
+  struct ds_test_resource * test  = &ds_test_resource_state;
+  struct ds_simulator       simulator;
+  struct ds_store           store;
+  struct ds_container       container;
+  char *                    tags  = test->tags;
+  enum ds_event_type        type  = DS_EVENT_TYPE_CUSTOM;
+
+  if ( !ds_simulator_initialize(&simulator, DS_TEST_RESOURCE_MAX_EVENTS, 64U, 1U, DS_MEMORY_DEFAULT) )
+    return EXIT_FAILURE;
+
+  ds_simulator_set_batch_handler(&simulator, type, ds_test_resource_handle);
+
+  test->num_logged  = 0U;
+
+  unsigned int num_free = ds_test_resource_count_free(&simulator);
+
+  if ( !ds_store_initialize(&store, &simulator, 2U) ) {
+    ds_simulator_deinitialize(&simulator);
+    return EXIT_FAILURE;
+  }
+
+  ds_store_get(&store, 0U, type);
+  ds_store_put(&store, 0U, tags + 10, type, tags + 1);
+  ds_store_put(&store, 0U, tags + 11, type, tags + 2);
+  ds_store_put(&store, 0U, tags + 12, type, tags + 3);
+  ds_store_put(&store, 0U, tags + 13, type, tags + 4);
+  ds_simulator_simulate(&simulator);
+
+  ds_store_get(&store, 1U, type);
+  ds_simulator_simulate(&simulator);
+
+  ds_store_get(&store, 2U, type);
+  ds_store_get(&store, 2U, type);
+  ds_simulator_simulate(&simulator);
+
+  unsigned int num_items  = store.num_items;
+
+  ds_store_deinitialize(&store);
+
+  if ( !ds_container_initialize(&container, &simulator, 10U, 5U) ) {
+    ds_simulator_deinitialize(&simulator);
+    return EXIT_FAILURE;
+  }
+
+  ds_container_get(&container, 3U, 7U, type, tags + 20);
+  ds_container_get(&container, 3U, 1U, type, tags + 21);
+  ds_container_put(&container, 3U, 3U, type, tags + 22);
+  ds_container_put(&container, 3U, 10U, type, tags + 23);
+  ds_container_put(&container, 3U, 1U, type, tags + 24);
+  ds_simulator_simulate(&simulator);
+
+  ds_container_get(&container, 4U, 2U, type, tags + 25);
+  ds_simulator_simulate(&simulator);
+
+  unsigned int level  = container.level;
+
+  /// a blocked get, then a stored item and a blocked put
+  ds_container_get(&container, 5U, 10U, type, tags + 26);
+
+  if ( !ds_store_initialize(&store, &simulator, 1U) ) {
+    ds_container_deinitialize(&container);
+    ds_simulator_deinitialize(&simulator);
+    return EXIT_FAILURE;
+  }
+
+  ds_store_put(&store, 5U, tags + 30, type, tags + 5);
+  ds_store_put(&store, 5U, tags + 31, type, tags + 6);
+  ds_simulator_simulate(&simulator);
+
+  ds_store_deinitialize(&store);
+  ds_container_deinitialize(&container);
+  ds_simulator_drain(&simulator);
+
+  unsigned int num_leaked   = num_free - ds_test_resource_count_free(&simulator);
+  unsigned int num_expected = sizeof(expected) / sizeof(*expected);
+  unsigned int num_wrong    = test->num_logged == num_expected ? 0U : 1U;
+
+  for ( unsigned int index = 0U; index < num_expected && index < test->num_logged; ++index ) {
+    if ( expected[ index ][ 0 ] != test->log[ index ][ 0 ]
+      || expected[ index ][ 1 ] != test->log[ index ][ 1 ] ) {
+      fprintf(stderr, "Mismatch: event %u is %u:%u, expected %u:%u.\n",
+        index,
+        test->log[ index ][ 0 ],
+        test->log[ index ][ 1 ],
+        expected[ index ][ 0 ],
+        expected[ index ][ 1 ]
+      );
+      ++num_wrong;
+    }
+  }
+
+  ds_simulator_deinitialize(&simulator);
+
+  printf("resource: %u events, %u wrong, %u items left, level %u, %u leaked\n",
+    test->num_logged,
+    num_wrong,
+    num_items,
+    level,
+    num_leaked
+  );
+
+  return 0U == num_wrong && 0U == num_items && 9U == level && 0U == num_leaked
+    ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main ( int argc, char const * const * argv )
+{
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "benchmark-pool") )
+    return ds_benchmark_pool();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "benchmark-process") )
+    return ds_benchmark_process(2 < argc
+      ? (unsigned int)strtoul(argv[ 2 ], NULL, 0) : DS_BENCHMARK_PROCESS_NUM_PROCESSES
+    );
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "benchmark-mmc") )
+    return ds_benchmark_mmc(2 < argc
+      ? (unsigned int)strtoul(argv[ 2 ], NULL, 0) : DS_BENCHMARK_MMC_NUM_CUSTOMERS
+    );
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "benchmark-pipeline") )
+    return ds_benchmark_pipeline(2 < argc
+      ? (unsigned int)strtoul(argv[ 2 ], NULL, 0) : DS_BENCHMARK_PIPELINE_NUM_EVENTS
+    );
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "benchmark-static") )
+    return ds_benchmark_static();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "benchmark-tlb") )
+    return ds_benchmark_tlb(2 < argc
+      ? (unsigned int)strtoul(argv[ 2 ], NULL, 0) : DS_BENCHMARK_TLB_NUM_EVENTS
+    );
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "test-skiplist") )
+    return ds_test_skiplist();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "test-pipeline") )
+    return ds_test_pipeline();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "test-timeline") )
+    return ds_test_timeline();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "test-adapt") )
+    return ds_test_adapt();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "test-spill") )
+    return ds_test_spill();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "test-sink") )
+    return ds_test_sink();
+
+  if ( 1 < argc && 0 == strcmp(argv[ 1 ], "test-resource") )
+    return ds_test_resource();
+
+  struct ds_sink sink;
+
+  if ( !ds_sink_initialize(&sink, STDOUT_FILENO, DS_EVENT_FORMAT_TEXT, 64U * 1024U) )
+    return EXIT_FAILURE;
+
+  struct ds_simulator simulator;
+
+  if ( !ds_simulator_initialize(&simulator, 1024U, 256U, 1U, DS_MEMORY_DEFAULT) ) {
+    ds_sink_deinitialize(&sink);
+    return EXIT_FAILURE;
+  }
+
+  ds_simulator_set_sink(&simulator, &sink);
+
+  /// watch with `ash-top <pid>`
+  struct ds_telemetry telemetry;
+  bool                is_published  = 1 < argc && 0 == strcmp(argv[ 1 ], "--telemetry")
+    && ds_telemetry_initialize(&telemetry, NULL);
+
+  if ( is_published ) {
+    ds_simulator_set_telemetry(&simulator, &telemetry);
+  }
+
+  int exit_code = EXIT_SUCCESS;
+
+  for ( int index = 0; index < 10; ++index ) {
+    ds_sink_printf(&sink, ">>> Scheduling event %d...\n", index);
+    bool is_okay  = ds_simulator_schedule(&simulator,
+      (unsigned int)( index >> 1U ),
+      DS_EVENT_TYPE_CUSTOM,
+      (void *)&simulator
+    );
+
+    if ( !is_okay ) {
+      exit_code = EXIT_FAILURE;
+      break;
+    }
+    ds_sink_printf(&sink, "... Scheduled event %d.\n", index);
+  }
+
+  if ( EXIT_SUCCESS == exit_code ) {
+    unsigned int max_steps  = 1024U * 1024U;
+    unsigned int num_steps;
+
+    for ( num_steps = 0; num_steps < max_steps; ++num_steps ) {
+      ds_sink_printf(&sink, "\n### =========================\n");
+      ds_sink_printf(&sink, ">>> Processing t=%u, dt=%u...\n",
+        simulator.time,
+        simulator.time_step
+      );
+      unsigned int num_events = ds_simulator_simulate(&simulator);
+      ds_sink_printf(&sink, "... Processed %u events.\n", num_events);
+      ds_sink_printf(&sink, "### =========================\n");
+
+      if ( ds_simulator_is_empty(&simulator) )
+        break;
+    }
+    ds_sink_printf(&sink, "Simulated %u step%s.\nEnd of Simulation.\n",
+      num_steps,
+      num_steps == 1U ? "" : "s"
+    );
+
+    unsigned num_drained_events = ds_simulator_drain(&simulator);
+    ds_sink_printf(&sink, "%u event%s ha%s been drained.\n",
+      num_drained_events,
+      num_drained_events == 1U  ? ""  : "s",
+      num_drained_events == 1U  ? "s" : "ve"
+    );
+  }
+
+  ds_simulator_deinitialize(&simulator);
+
+  if ( is_published ) {
+    ds_telemetry_deinitialize(&telemetry);
+  }
+
+  if ( !ds_sink_deinitialize(&sink) ) {
+    exit_code = EXIT_FAILURE;
+  }
+
+  return exit_code;
+}
+
+/// SOURCES
+
+# include <limits.h>
+# include <assert.h>
+# include <string.h>
+# include <errno.h>
+# include <math.h>
+# include <unistd.h>
+# include <time.h>
+# include <sys/prctl.h>
+# include <sys/epoll.h>
+# include <sys/timerfd.h>
+# include <sys/uio.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+
+# define UNREACHABLE()                                                        \
+  do {                                                                        \
+    fprintf(stderr, "Unreachable point has been reached!\n");                 \
+    abort();                                                                  \
+  } while ( false )
+
+# define ERROR(format, ...)     fprintf(stderr, "[ERROR] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+# define ALERT(format, ...)     fprintf(stderr, "[ALERT] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+# define NOTE(format, ...)      fprintf(stderr, "[NOTE ] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+# define INFO(format, ...)      fprintf(stderr, "[INFO ] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+# define DEBUG(format, ...)     fprintf(stderr, "[DEBUG] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+# define TRACE(format, ...)     fprintf(stderr, "[TRACE] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+
+# if defined(__x86_64__) || defined(__i386__)
+#   define CPU_RELAX()          __builtin_ia32_pause()
+# elif defined(__aarch64__)
+#   define CPU_RELAX()          __asm__ __volatile__ ( "yield" )
+# else
+#   define CPU_RELAX()          do { } while ( false )
+# endif
+
+# if defined(__GNUC__)
+#   define PREFETCH(address)    __builtin_prefetch((address))
+# else
+#   define PREFETCH(address)    do { (void)( address ); } while ( false )
+# endif
+
+# define DS_MEMORY_HUGE_PAGE_SIZE   ( 2UL * 1024UL * 1024UL )
+
+/// from <numaif.h>, without depending on libnuma
+# ifndef MPOL_BIND
+#   define MPOL_BIND            2
+# endif
+
+/// Memory
+
+static size_t ds_memory_length (
+  size_t                        size,
+  enum ds_memory_flags          flags
+)
+{
+  size_t page_size  = 0U != ( flags & DS_MEMORY_HUGE_PAGES )
+    ? DS_MEMORY_HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+
+  return ( size + page_size - 1U ) / page_size * page_size;
+}
+
+static void ds_memory_bind (
+  void *                        memory,
+  size_t                        length
+)
+{
+  unsigned int  cpu;
+  unsigned int  node;
+  unsigned long nodes [ 16 ] = { 0UL };
+  size_t        num_bits  = CHAR_BIT * sizeof(nodes[ 0 ]);
+
+  if ( 0 != syscall(SYS_getcpu, &cpu, &node, NULL) ) {
+    ALERT("Cannot find the NUMA node of the thread: %s.", strerror(errno));
+    return;
+  }
+
+  if ( CHAR_BIT * sizeof(nodes) <= node )
+    return;
+
+  nodes[ node / num_bits ] |= 1UL << ( node % num_bits );
+
+  /// before the first touch, so that nothing has to move
+  if ( 0 != syscall(SYS_mbind, memory, length, MPOL_BIND, nodes, CHAR_BIT * sizeof(nodes), 0U) ) {
+    ALERT("Cannot bind %zu bytes to NUMA node %u: %s.",
+      length,
+      node,
+      strerror(errno)
+    );
+  }
+}
+
+static void * ds_memory_allocate (
+  size_t                        size,
+  enum ds_memory_flags          flags
+)
+{
+  if ( DS_MEMORY_DEFAULT == flags )
+    return malloc(size);
+
+  size_t length = ds_memory_length(size, flags);
+  void * memory = MAP_FAILED;
+
+  if ( 0U != ( flags & DS_MEMORY_HUGE_PAGES ) ) {
+    memory  = mmap(NULL,
+      length,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+      -1,
+      0
+    );
+  }
+
+  if ( MAP_FAILED == memory ) {
+    /// over-allocate to align on a huge page, for transparent ones
+    size_t padding  = 0U != ( flags & DS_MEMORY_HUGE_PAGES ) ? DS_MEMORY_HUGE_PAGE_SIZE : 0U;
+
+    memory  = mmap(NULL,
+      length + padding,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0
+    );
+
+    if ( MAP_FAILED == memory )
+      return NULL;
+
+    if ( 0U != padding ) {
+      char * begin  = (char *)memory;
+      char * end    = begin + length + padding;
+      char * aligned  = (char *)( ( (uintptr_t)begin + padding - 1U ) & ~(uintptr_t)( padding - 1U ) );
+
+      if ( aligned > begin ) {
+        munmap(begin, (size_t)( aligned - begin ));
+      }
+
+      if ( end > aligned + length ) {
+        munmap(aligned + length, (size_t)( end - aligned - length ));
+      }
+
+      memory  = aligned;
+      madvise(memory, length, MADV_HUGEPAGE);
+    }
+  }
+
+  if ( 0U != ( flags & DS_MEMORY_LOCAL_NODE ) ) {
+    ds_memory_bind(memory, length);
+  }
+
+  return memory;
+}
+
+static void ds_memory_free (
+  void *                        memory,
+  size_t                        size,
+  enum ds_memory_flags          flags
+)
+{
+  if ( DS_MEMORY_DEFAULT == flags ) {
+    free(memory);
+    return;
+  }
+
+  munmap(memory, ds_memory_length(size, flags));
+}
+
+/// Event
+
+static char const * const ds_event_types [ DS_NUM_EVENT_TYPES ]  = {
+  [ DS_EVENT_TYPE_CUSTOM ]  = "CUSTOM",
+  [ DS_EVENT_TYPE_PROCESS ] = "PROCESS"
+};
+
+bool ds_event_initialize (
+  struct ds_event *             self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( (int)DS_NUM_EVENT_TYPES <= (int)type ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "type",
+      "Out of range [0;DS_NUM_EVENT_TYPES-1]"
+    );
+    return false;
+  }
+
+  self->next  = (struct ds_event *)NULL;
+  self->time  = time;
+  self->type  = type;
+  self->data  = data;
+
+  return true;
+}
+
+void ds_event_deinitialize (
+  struct ds_event *             self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL == (void *)self->next);
+  assert((int)DS_NUM_EVENT_TYPES > (int)self->type);
+
+  self->next  = (struct ds_event *)NULL;
+  self->time  = 0U;
+  self->type  = DS_NUM_EVENT_TYPES;
+  self->data  = NULL;
+}
+
+bool ds_event_process (
+  struct ds_event *             self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL == (void *)self->next);
+  assert((int)DS_NUM_EVENT_TYPES > (int)self->type);
+
+  if ( DS_EVENT_TYPE_PROCESS == self->type ) {
+    ds_process_resume((struct ds_process *)self->data, self->time);
+    return true;
+  }
+
+  if ( DS_EVENT_TYPE_CUSTOM == self->type && NULL != self->data ) {
+    struct ds_simulator * simulator = (struct ds_simulator *)self->data;
+
+    DEBUG(">>> (Re)Scheduling event <%p>...", self);
+    bool is_okay  = ds_simulator_schedule(simulator,
+      self->time + 10U,
+      self->type,
+      self->data
+    );
+    DEBUG("... %scheduled event <%p> @ %u.",
+      is_okay ? "(Re)S" : "Not (re)s",
+      self,
+      self->time + 10U
+    );
+  }
+
+  return false;
+}
+
+bool ds_event_display (
+  struct ds_event *             self,
+  FILE *                        file
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL == (void *)self->next);
+  assert((int)DS_NUM_EVENT_TYPES > (int)self->type);
+
+  if ( NULL == (void *)file ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "file",
+      "Unexpected null pointer"
+    );
+    return false;
+  }
+
+  char buffer [ 256 ];
+  int  num_chars  = ds_event_serialize(self, DS_EVENT_FORMAT_TEXT, buffer, sizeof(buffer));
+
+  if ( 0 >= num_chars || sizeof(buffer) <= (size_t)num_chars )
+    return false;
+
+  return 1U == fwrite(buffer, (size_t)num_chars, 1U, file);
+}
+
+int ds_event_serialize (
+  struct ds_event *             self,
+  enum ds_event_format          format,
+  char *                        buffer,
+  size_t                        size
+)
+{
+  assert(NULL != (void *)self);
+  assert((int)DS_NUM_EVENT_TYPES > (int)self->type);
+
+  switch ( format ) {
+  case DS_EVENT_FORMAT_TEXT:
+    return snprintf(buffer, size, "Event <%p>: next=<%p> type=%s data=<%p> @ %u\n",
+      (void *)self,
+      (void *)self->next,
+      ds_event_types[ (int)self->type ],
+      self->data,
+      self->time
+    );
+
+  case DS_EVENT_FORMAT_CSV:
+    return snprintf(buffer, size, "%u,%s,%p\n",
+      self->time,
+      ds_event_types[ (int)self->type ],
+      self->data
+    );
+
+  case DS_EVENT_FORMAT_BINARY: {
+    struct ds_event_record record = {
+      .time = (uint32_t)self->time,
+      .type = (uint32_t)self->type,
+      .data = (uint64_t)(uintptr_t)self->data
+    };
+
+    if ( sizeof(record) <= size ) {
+      memcpy(buffer, &record, sizeof(record));
+    }
+
+    return (int)sizeof(record);
+  }
+
+  default:
+    ERROR("Invalid argument `%s`: %s.",
+      "format",
+      "Out of range [0;DS_NUM_EVENT_FORMATS-1]"
+    );
+    return -1;
+  }
+}
+
+/// Event Pool
+
+bool ds_event_pool_initialize (
+  struct ds_event_pool *        self,
+  unsigned int                  max_events,
+  enum ds_memory_flags          flags
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == max_events ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "max_events",
+      "Out of range [1;MAX_UINT]"
+    );
+    return false;
+  }
+
+  struct ds_event * events
+    = (struct ds_event *)ds_memory_allocate(
+      (size_t)max_events * sizeof(*events),
+      flags
+    );
+
+  if ( NULL == (void *)events ) {
+    ERROR("Cannot allocate %u events: %s.",
+      max_events,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  self->events            = events;
+  self->max_events        = max_events;
+  self->free_event        = events;
+  self->caches            = (struct ds_event_cache *)NULL;
+  self->num_caches        = 0U;
+  self->magazines         = (struct ds_event_magazine *)NULL;
+  self->num_magazines     = 0U;
+  self->full_magazine     = (struct ds_event_magazine *)NULL;
+  self->empty_magazine    = (struct ds_event_magazine *)NULL;
+  self->partial_magazine  = (struct ds_event_magazine *)NULL;
+  self->flags             = flags;
+
+  /// initialize the free list
+
+  events->next  = (struct ds_event *)NULL;
+
+  for ( unsigned int index  = 1U; index < max_events; ++index ) {
+    struct ds_event * prev  = events + index - 1U;
+    struct ds_event * curr  = events + index;
+
+    prev->next  = curr;
+    curr->next  = (struct ds_event *)NULL;
+  }
+
+  return true;
+}
+
+void ds_event_pool_deinitialize (
+  struct ds_event_pool *        self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->events);
+  assert(0U != self->max_events);
+
+  if ( NULL != (void *)self->caches ) {
+    pthread_mutex_destroy(&self->lock);
+    free(self->magazines);
+    free(self->caches);
+  }
+
+  ds_memory_free(self->events,
+    (size_t)self->max_events * sizeof(*self->events),
+    self->flags
+  );
+}
+
+struct ds_event * ds_event_pool_acquire (
+  struct ds_event_pool *        self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->events);
+  assert(0U != self->max_events);
+
+  if ( NULL != (void *)self->caches )
+    return ds_event_cache_acquire(self->caches, time, type, data);
+
+  struct ds_event * event = self->free_event;
+
+  if ( NULL == (void *)event ) {
+    ERROR("Out of memory: Maximum number of events (%u) has been reached.",
+      self->max_events
+    );
+    return event;
+  }
+
+  struct ds_event * free_event  = event->next;
+
+  bool is_okay  = ds_event_initialize(event,
+    time,
+    type,
+    data
+  );
+
+  if ( !is_okay )
+    return (struct ds_event *)NULL;
+
+  self->free_event  = free_event;
+  return event;
+}
+
+void ds_event_pool_release (
+  struct ds_event_pool *        self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->events);
+  assert(0U != self->max_events);
+
+  assert(NULL != (void *)event);
+  assert(NULL == (void *)event->next);
+
+  if ( NULL != (void *)self->caches ) {
+    ds_event_cache_release(self->caches, event);
+    return;
+  }
+
+  ds_event_deinitialize(event);
+  event->next       = self->free_event;
+  self->free_event  = event;
+}
+
+bool ds_event_pool_partition (
+  struct ds_event_pool *        self,
+  unsigned int                  num_caches
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->events);
+
+  if ( 0U == num_caches || self->max_events < num_caches ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "num_caches",
+      "Out of range [1;max_events]"
+    );
+    return false;
+  }
+
+  if ( NULL != (void *)self->caches ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "self",
+      "Already partitioned"
+    );
+    return false;
+  }
+
+  /// the first cache is the one of the thread owning the pool
+  struct ds_event_cache * caches
+    = (struct ds_event_cache *)aligned_alloc(
+      _Alignof(struct ds_event_cache),
+      (size_t)( num_caches + 1U ) * sizeof(*caches)
+    );
+
+  if ( NULL == (void *)caches ) {
+    ERROR("Cannot allocate %u caches: %s.",
+      num_caches + 1U,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  /// two per cache, and the full and partial ones of the depot: an empty one
+  /// is always left for a cache whose magazines are both full
+  unsigned int num_magazines  = ( self->max_events - 1U ) / DS_MAGAZINE_SIZE + 2U
+    + 2U * ( num_caches + 1U );
+
+  struct ds_event_magazine * magazines
+    = (struct ds_event_magazine *)malloc((size_t)num_magazines * sizeof(*magazines));
+
+  if ( NULL == (void *)magazines ) {
+    ERROR("Cannot allocate %u magazines: %s.",
+      num_magazines,
+      strerror(errno)
+    );
+    free(caches);
+    return false;
+  }
+
+  pthread_mutex_init(&self->lock, NULL);
+  self->full_magazine     = (struct ds_event_magazine *)NULL;
+  self->empty_magazine    = (struct ds_event_magazine *)NULL;
+  self->partial_magazine  = (struct ds_event_magazine *)NULL;
+
+  for ( unsigned int index = num_magazines; 0U < index; --index ) {
+    struct ds_event_magazine * magazine = magazines + index - 1U;
+
+    magazine->num_events  = 0U;
+    magazine->next        = self->empty_magazine;
+    self->empty_magazine  = magazine;
+  }
+
+  for ( unsigned int index = 0U; index <= num_caches; ++index ) {
+    struct ds_event_cache * cache = caches + index;
+
+    atomic_init(&cache->is_attached, 0U == index);
+    cache->pool           = self;
+    cache->loaded         = self->empty_magazine;
+    cache->previous       = self->empty_magazine->next;
+    cache->num_exchanges  = 0ULL;
+    self->empty_magazine  = cache->previous->next;
+  }
+
+  /// fill magazines with the free events: the full ones go to the depot, the
+  /// last one is loaded into the cache of the owner
+  struct ds_event_magazine * magazine = caches->loaded;
+
+  while ( NULL != (void *)self->free_event ) {
+    struct ds_event * event = self->free_event;
+
+    if ( DS_MAGAZINE_SIZE == magazine->num_events ) {
+      struct ds_event_magazine * empty  = self->empty_magazine;
+
+      self->empty_magazine  = empty->next;
+      magazine->next        = self->full_magazine;
+      self->full_magazine   = magazine;
+      magazine              = empty;
+    }
+
+    self->free_event  = event->next;
+    event->next       = (struct ds_event *)NULL;
+    magazine->events[ magazine->num_events++ ] = event;
+  }
+
+  caches->loaded        = magazine;
+  self->caches          = caches;
+  self->num_caches      = num_caches;
+  self->magazines       = magazines;
+  self->num_magazines   = num_magazines;
+
+  return true;
+}
+
+struct ds_event_cache * ds_event_pool_attach (
+  struct ds_event_pool *        self
+)
+{
+  assert(NULL != (void *)self);
+
+  for ( unsigned int index = 1U; index <= self->num_caches; ++index ) {
+    struct ds_event_cache * cache = self->caches + index;
+
+    if ( !atomic_exchange(&cache->is_attached, true) )
+      return cache;
+  }
+
+  ERROR("Out of memory: Maximum number of threads (%u) has been reached.",
+    self->num_caches
+  );
+  return (struct ds_event_cache *)NULL;
+}
+
+void ds_event_pool_detach (
+  struct ds_event_cache *       cache
+)
+{
+  assert(NULL != (void *)cache);
+  assert(atomic_load(&cache->is_attached));
+  assert(cache != cache->pool->caches);
+
+  struct ds_event_pool * pool = cache->pool;
+
+  /// pour the events of both magazines into the partial one of the depot
+  pthread_mutex_lock(&pool->lock);
+
+  for ( struct ds_event_magazine * magazine = cache->loaded;
+        NULL != (void *)magazine;
+        magazine = magazine == cache->loaded ? cache->previous : (struct ds_event_magazine *)NULL ) {
+    while ( 0U < magazine->num_events ) {
+      struct ds_event_magazine * partial = pool->partial_magazine;
+
+      if ( NULL == (void *)partial ) {
+        partial                 = pool->empty_magazine;
+        pool->empty_magazine    = partial->next;
+        pool->partial_magazine  = partial;
+      }
+
+      partial->events[ partial->num_events++ ] = magazine->events[ --magazine->num_events ];
+
+      if ( DS_MAGAZINE_SIZE == partial->num_events ) {
+        partial->next           = pool->full_magazine;
+        pool->full_magazine     = partial;
+        pool->partial_magazine  = (struct ds_event_magazine *)NULL;
+      }
+    }
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  atomic_store(&cache->is_attached, false);
+}
+
+/// loads a magazine of free events: the previous one if it is full, otherwise
+/// one from the depot, for the empty previous one
+static bool ds_event_cache_reload (
+  struct ds_event_cache *       self
+)
+{
+  struct ds_event_magazine * magazine = self->previous;
+
+  if ( 0U == magazine->num_events ) {
+    struct ds_event_pool * pool = self->pool;
+
+    pthread_mutex_lock(&pool->lock);
+
+    struct ds_event_magazine * full = pool->full_magazine;
+
+    /// the partial one left by detached caches, once no full one is left
+    if ( NULL == (void *)full ) {
+      full                    = pool->partial_magazine;
+      pool->partial_magazine  = (struct ds_event_magazine *)NULL;
+    } else {
+      pool->full_magazine     = full->next;
+    }
+
+    if ( NULL != (void *)full ) {
+      magazine->next        = pool->empty_magazine;
+      pool->empty_magazine  = magazine;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    if ( NULL == (void *)full )
+      return false;
+
+    ++self->num_exchanges;
+    magazine  = full;
+  }
+
+  self->previous  = self->loaded;
+  self->loaded    = magazine;
+
+  return true;
+}
+
+/// loads a magazine with room: the previous one if it is empty, otherwise one
+/// from the depot, for the full previous one
+static void ds_event_cache_unload (
+  struct ds_event_cache *       self
+)
+{
+  struct ds_event_magazine * magazine = self->previous;
+
+  if ( 0U != magazine->num_events ) {
+    struct ds_event_pool * pool = self->pool;
+
+    pthread_mutex_lock(&pool->lock);
+
+    struct ds_event_magazine * empty  = pool->empty_magazine;
+
+    assert(NULL != (void *)empty);
+
+    pool->empty_magazine  = empty->next;
+    magazine->next        = pool->full_magazine;
+    pool->full_magazine   = magazine;
+
+    pthread_mutex_unlock(&pool->lock);
+
+    ++self->num_exchanges;
+    magazine  = empty;
+  }
+
+  self->previous  = self->loaded;
+  self->loaded    = magazine;
+}
+
+struct ds_event * ds_event_cache_acquire (
+  struct ds_event_cache *       self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+  assert(atomic_load_explicit(&self->is_attached, memory_order_relaxed));
+
+  if ( 0U == self->loaded->num_events && !ds_event_cache_reload(self) ) {
+    ERROR("Out of memory: Maximum number of events (%u) has been reached.",
+      self->pool->max_events
+    );
+    return (struct ds_event *)NULL;
+  }
+
+  struct ds_event_magazine *  loaded  = self->loaded;
+  struct ds_event *           event   = loaded->events[ loaded->num_events - 1U ];
+
+  bool is_okay  = ds_event_initialize(event,
+    time,
+    type,
+    data
+  );
+
+  if ( !is_okay )
+    return (struct ds_event *)NULL;
+
+  --loaded->num_events;
+  return event;
+}
+
+void ds_event_cache_release (
+  struct ds_event_cache *       self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+  assert(NULL == (void *)event->next);
+
+  ds_event_deinitialize(event);
+
+  if ( DS_MAGAZINE_SIZE == self->loaded->num_events ) {
+    ds_event_cache_unload(self);
+  }
+
+  struct ds_event_magazine * loaded = self->loaded;
+
+  loaded->events[ loaded->num_events++ ] = event;
+}
+
+/// Event List
+
+void ds_event_list_initialize (
+  struct ds_event_list *        self
+)
+{
+  assert(NULL != (void *)self);
+
+  self->head = (struct ds_event *)NULL;
+  self->tail = (struct ds_event *)NULL;
+}
+
+void ds_event_list_deinitialize (
+  struct ds_event_list *        self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL == (void *)self->head);
+  assert(NULL == (void *)self->tail);
+
+  (void)self;
+}
+
+void ds_event_list_insert (
+  struct ds_event_list *        self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+  assert(NULL == (void *)event->next);
+
+  if ( NULL == (void *)self->head ) {
+    self->head  = event;
+    self->tail  = event;
+  } else {
+    self->tail->next  = event;
+    self->tail  = event;
+  }
+}
+
+void ds_event_list_insert_front (
+  struct ds_event_list *        self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+  assert(NULL == (void *)event->next);
+
+  if ( NULL == (void *)self->head ) {
+    self->tail  = event;
+  }
+
+  event->next = self->head;
+  self->head  = event;
+}
+
+struct ds_event * ds_event_list_remove (
+  struct ds_event_list *        self
+)
+{
+  assert(NULL != (void *)self);
+
+  struct ds_event * event = self->head;
+
+  if ( NULL == (void *)event )
+    return event;
+
+  self->head  = event->next;
+  event->next = (struct ds_event *)NULL;
+
+  if ( NULL == (void *)self->head ) {
+    self->tail  = self->head;
+  }
+
+  return event;
+}
+
+bool ds_event_list_is_empty (
+  struct ds_event_list *        self
+)
+{
+  assert(NULL != (void *)self);
+
+  return NULL == (void *)self->head;
+}
+
+/// Event Bin
+
+bool ds_event_bin_initialize (
+  struct ds_event_bin *         self,
+  struct ds_event *             event,
+  bool                          is_grouped
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( NULL == (void *)event ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "event",
+      "Unexpected null pointer"
+    );
+    return false;
+  }
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    ds_event_list_initialize(self->events + type);
+  }
+
+  self->next        = (struct ds_event_bin *)NULL;
+  self->time        = event->time;
+  self->is_grouped  = is_grouped;
+
+  /// insert the first event
+  ds_event_bin_insert(self, event);
+
+  return true;
+}
+
+void ds_event_bin_deinitialize (
+  struct ds_event_bin *         self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL == (void *)self->next);
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    ds_event_list_deinitialize(self->events + type);
+  }
+}
+
+void ds_event_bin_insert (
+  struct ds_event_bin *         self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+
+  int type  = self->is_grouped ? (int)event->type : 0;
+
+  ds_event_list_insert(self->events + type, event);
+}
+
+void ds_event_bin_insert_front (
+  struct ds_event_bin *         self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+
+  int type  = self->is_grouped ? (int)event->type : 0;
+
+  ds_event_list_insert_front(self->events + type, event);
+}
+
+struct ds_event * ds_event_bin_remove (
+  struct ds_event_bin *         self
+)
+{
+  assert(NULL != (void *)self);
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    if ( !ds_event_list_is_empty(self->events + type) )
+      return ds_event_list_remove(self->events + type);
+  }
+
+  return (struct ds_event *)NULL;
+}
+
+struct ds_event * ds_event_bin_peek (
+  struct ds_event_bin *         self
+)
+{
+  assert(NULL != (void *)self);
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    if ( !ds_event_list_is_empty(self->events + type) )
+      return self->events[ type ].head;
+  }
+
+  return (struct ds_event *)NULL;
+}
+
+bool ds_event_bin_is_empty (
+  struct ds_event_bin *         self
+)
+{
+  assert(NULL != (void *)self);
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    if ( !ds_event_list_is_empty(self->events + type) )
+      return false;
+  }
+
+  return true;
+}
+
+/// Event Bin Pool
+
+bool ds_event_bin_pool_initialize (
+  struct ds_event_bin_pool *    self,
+  unsigned int                  max_bins,
+  enum ds_memory_flags          flags
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == max_bins ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "max_bins",
+      "Out of range [1;MAX_UINT]"
+    );
+    return false;
+  }
+
+  struct ds_event_bin * bins
+    = (struct ds_event_bin *)ds_memory_allocate(
+      (size_t)max_bins * sizeof(*bins),
+      flags
+    );
+
+  if ( NULL == (void *)bins ) {
+    ERROR("Cannot allocate %u bins: %s.",
+      max_bins,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  self->bins              = bins;
+  self->max_bins          = max_bins;
+  self->free_bin          = bins;
+  self->caches            = (struct ds_event_bin_cache *)NULL;
+  self->num_caches        = 0U;
+  self->magazines         = (struct ds_event_bin_magazine *)NULL;
+  self->num_magazines     = 0U;
+  self->full_magazine     = (struct ds_event_bin_magazine *)NULL;
+  self->empty_magazine    = (struct ds_event_bin_magazine *)NULL;
+  self->partial_magazine  = (struct ds_event_bin_magazine *)NULL;
+  self->flags             = flags;
+
+  /// initialize the free list
+
+  bins->next  = (struct ds_event_bin *)NULL;
+
+  for ( unsigned int index  = 1U; index < max_bins; ++index ) {
+    struct ds_event_bin * prev  = bins + index - 1U;
+    struct ds_event_bin * curr  = bins + index;
+
+    prev->next  = curr;
+    curr->next  = (struct ds_event_bin *)NULL;
+  }
+
+  return true;
+}
+
+void ds_event_bin_pool_deinitialize (
+  struct ds_event_bin_pool *    self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->bins);
+  assert(0U != self->max_bins);
+
+  if ( NULL != (void *)self->caches ) {
+    pthread_mutex_destroy(&self->lock);
+    free(self->magazines);
+    free(self->caches);
+  }
+
+  ds_memory_free(self->bins,
+    (size_t)self->max_bins * sizeof(*self->bins),
+    self->flags
+  );
+}
+
+struct ds_event_bin * ds_event_bin_pool_acquire (
+  struct ds_event_bin_pool *    self,
+  struct ds_event *             event,
+  bool                          is_grouped
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->bins);
+  assert(0U != self->max_bins);
+
+  if ( NULL != (void *)self->caches )
+    return ds_event_bin_cache_acquire(self->caches, event, is_grouped);
+
+  struct ds_event_bin * bin = self->free_bin;
+
+  if ( NULL == (void *)bin ) {
+    ERROR("Out of memory: Maximum number of event bins (%u) has been reached.",
+      self->max_bins
+    );
+    return bin;
+  }
+
+  struct ds_event_bin * free_bin  = bin->next;
+
+  bool is_okay  = ds_event_bin_initialize(bin, event, is_grouped);
+
+  if ( !is_okay )
+    return (struct ds_event_bin *)NULL;
+
+  self->free_bin  = free_bin;
+  return bin;
+}
+
+void ds_event_bin_pool_release (
+  struct ds_event_bin_pool *    self,
+  struct ds_event_bin *         bin
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->bins);
+  assert(0U != self->max_bins);
+
+  assert(NULL != (void *)bin);
+  assert(NULL == (void *)bin->next);
+
+  if ( NULL != (void *)self->caches ) {
+    ds_event_bin_cache_release(self->caches, bin);
+    return;
+  }
+
+  ds_event_bin_deinitialize(bin);
+  bin->next       = self->free_bin;
+  self->free_bin  = bin;
+}
+
+bool ds_event_bin_pool_partition (
+  struct ds_event_bin_pool *    self,
+  unsigned int                  num_caches
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->bins);
+
+  if ( 0U == num_caches || self->max_bins < num_caches ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "num_caches",
+      "Out of range [1;max_bins]"
+    );
+    return false;
+  }
+
+  if ( NULL != (void *)self->caches ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "self",
+      "Already partitioned"
+    );
+    return false;
+  }
+
+  /// the first cache is the one of the thread owning the pool
+  struct ds_event_bin_cache * caches
+    = (struct ds_event_bin_cache *)aligned_alloc(
+      _Alignof(struct ds_event_bin_cache),
+      (size_t)( num_caches + 1U ) * sizeof(*caches)
+    );
+
+  if ( NULL == (void *)caches ) {
+    ERROR("Cannot allocate %u caches: %s.",
+      num_caches + 1U,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  /// two per cache, and the full and partial ones of the depot: an empty one
+  /// is always left for a cache whose magazines are both full
+  unsigned int num_magazines  = ( self->max_bins - 1U ) / DS_MAGAZINE_SIZE + 2U
+    + 2U * ( num_caches + 1U );
+
+  struct ds_event_bin_magazine * magazines
+    = (struct ds_event_bin_magazine *)malloc((size_t)num_magazines * sizeof(*magazines));
+
+  if ( NULL == (void *)magazines ) {
+    ERROR("Cannot allocate %u magazines: %s.",
+      num_magazines,
+      strerror(errno)
+    );
+    free(caches);
+    return false;
+  }
+
+  pthread_mutex_init(&self->lock, NULL);
+  self->full_magazine     = (struct ds_event_bin_magazine *)NULL;
+  self->empty_magazine    = (struct ds_event_bin_magazine *)NULL;
+  self->partial_magazine  = (struct ds_event_bin_magazine *)NULL;
+
+  for ( unsigned int index = num_magazines; 0U < index; --index ) {
+    struct ds_event_bin_magazine * magazine = magazines + index - 1U;
+
+    magazine->num_bins    = 0U;
+    magazine->next        = self->empty_magazine;
+    self->empty_magazine  = magazine;
+  }
+
+  for ( unsigned int index = 0U; index <= num_caches; ++index ) {
+    struct ds_event_bin_cache * cache = caches + index;
+
+    atomic_init(&cache->is_attached, 0U == index);
+    cache->pool           = self;
+    cache->loaded         = self->empty_magazine;
+    cache->previous       = self->empty_magazine->next;
+    cache->num_exchanges  = 0ULL;
+    self->empty_magazine  = cache->previous->next;
+  }
+
+  /// fill magazines with the free bins: the full ones go to the depot, the
+  /// last one is loaded into the cache of the owner
+  struct ds_event_bin_magazine * magazine = caches->loaded;
+
+  while ( NULL != (void *)self->free_bin ) {
+    struct ds_event_bin * bin = self->free_bin;
+
+    if ( DS_MAGAZINE_SIZE == magazine->num_bins ) {
+      struct ds_event_bin_magazine * empty  = self->empty_magazine;
+
+      self->empty_magazine  = empty->next;
+      magazine->next        = self->full_magazine;
+      self->full_magazine   = magazine;
+      magazine              = empty;
+    }
+
+    self->free_bin    = bin->next;
+    bin->next         = (struct ds_event_bin *)NULL;
+    magazine->bins[ magazine->num_bins++ ] = bin;
+  }
+
+  caches->loaded        = magazine;
+  self->caches          = caches;
+  self->num_caches      = num_caches;
+  self->magazines       = magazines;
+  self->num_magazines   = num_magazines;
+
+  return true;
+}
+
+struct ds_event_bin_cache * ds_event_bin_pool_attach (
+  struct ds_event_bin_pool *    self
+)
+{
+  assert(NULL != (void *)self);
+
+  for ( unsigned int index = 1U; index <= self->num_caches; ++index ) {
+    struct ds_event_bin_cache * cache = self->caches + index;
+
+    if ( !atomic_exchange(&cache->is_attached, true) )
+      return cache;
+  }
+
+  ERROR("Out of memory: Maximum number of threads (%u) has been reached.",
+    self->num_caches
+  );
+  return (struct ds_event_bin_cache *)NULL;
+}
+
+void ds_event_bin_pool_detach (
+  struct ds_event_bin_cache *   cache
+)
+{
+  assert(NULL != (void *)cache);
+  assert(atomic_load(&cache->is_attached));
+  assert(cache != cache->pool->caches);
+
+  struct ds_event_bin_pool * pool = cache->pool;
+
+  /// pour the bins of both magazines into the partial one of the depot
+  pthread_mutex_lock(&pool->lock);
+
+  for ( struct ds_event_bin_magazine * magazine = cache->loaded;
+        NULL != (void *)magazine;
+        magazine = magazine == cache->loaded ? cache->previous : (struct ds_event_bin_magazine *)NULL ) {
+    while ( 0U < magazine->num_bins ) {
+      struct ds_event_bin_magazine * partial = pool->partial_magazine;
+
+      if ( NULL == (void *)partial ) {
+        partial                 = pool->empty_magazine;
+        pool->empty_magazine    = partial->next;
+        pool->partial_magazine  = partial;
+      }
+
+      partial->bins[ partial->num_bins++ ] = magazine->bins[ --magazine->num_bins ];
+
+      if ( DS_MAGAZINE_SIZE == partial->num_bins ) {
+        partial->next           = pool->full_magazine;
+        pool->full_magazine     = partial;
+        pool->partial_magazine  = (struct ds_event_bin_magazine *)NULL;
+      }
+    }
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  atomic_store(&cache->is_attached, false);
+}
+
+/// loads a magazine of free bins: the previous one if it is full, otherwise
+/// one from the depot, for the empty previous one
+static bool ds_event_bin_cache_reload (
+  struct ds_event_bin_cache *   self
+)
+{
+  struct ds_event_bin_magazine * magazine = self->previous;
+
+  if ( 0U == magazine->num_bins ) {
+    struct ds_event_bin_pool * pool = self->pool;
+
+    pthread_mutex_lock(&pool->lock);
+
+    struct ds_event_bin_magazine * full = pool->full_magazine;
+
+    /// the partial one left by detached caches, once no full one is left
+    if ( NULL == (void *)full ) {
+      full                    = pool->partial_magazine;
+      pool->partial_magazine  = (struct ds_event_bin_magazine *)NULL;
+    } else {
+      pool->full_magazine     = full->next;
+    }
+
+    if ( NULL != (void *)full ) {
+      magazine->next        = pool->empty_magazine;
+      pool->empty_magazine  = magazine;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    if ( NULL == (void *)full )
+      return false;
+
+    ++self->num_exchanges;
+    magazine  = full;
+  }
+
+  self->previous  = self->loaded;
+  self->loaded    = magazine;
+
+  return true;
+}
+
+/// loads a magazine with room: the previous one if it is empty, otherwise one
+/// from the depot, for the full previous one
+static void ds_event_bin_cache_unload (
+  struct ds_event_bin_cache *   self
+)
+{
+  struct ds_event_bin_magazine * magazine = self->previous;
+
+  if ( 0U != magazine->num_bins ) {
+    struct ds_event_bin_pool * pool = self->pool;
+
+    pthread_mutex_lock(&pool->lock);
+
+    struct ds_event_bin_magazine * empty  = pool->empty_magazine;
+
+    assert(NULL != (void *)empty);
+
+    pool->empty_magazine  = empty->next;
+    magazine->next        = pool->full_magazine;
+    pool->full_magazine   = magazine;
+
+    pthread_mutex_unlock(&pool->lock);
+
+    ++self->num_exchanges;
+    magazine  = empty;
+  }
+
+  self->previous  = self->loaded;
+  self->loaded    = magazine;
+}
+
+struct ds_event_bin * ds_event_bin_cache_acquire (
+  struct ds_event_bin_cache *   self,
+  struct ds_event *             event,
+  bool                          is_grouped
+)
+{
+  assert(NULL != (void *)self);
+  assert(atomic_load_explicit(&self->is_attached, memory_order_relaxed));
+
+  if ( 0U == self->loaded->num_bins && !ds_event_bin_cache_reload(self) ) {
+    ERROR("Out of memory: Maximum number of event bins (%u) has been reached.",
+      self->pool->max_bins
+    );
+    return (struct ds_event_bin *)NULL;
+  }
+
+  struct ds_event_bin_magazine * loaded  = self->loaded;
+  struct ds_event_bin *         bin     = loaded->bins[ loaded->num_bins - 1U ];
+
+  bool is_okay  = ds_event_bin_initialize(bin, event, is_grouped);
+
+  if ( !is_okay )
+    return (struct ds_event_bin *)NULL;
+
+  --loaded->num_bins;
+  return bin;
+}
+
+void ds_event_bin_cache_release (
+  struct ds_event_bin_cache *   self,
+  struct ds_event_bin *         bin
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)bin);
+  assert(NULL == (void *)bin->next);
+
+  ds_event_bin_deinitialize(bin);
+
+  if ( DS_MAGAZINE_SIZE == self->loaded->num_bins ) {
+    ds_event_bin_cache_unload(self);
+  }
+
+  struct ds_event_bin_magazine * loaded = self->loaded;
+
+  loaded->bins[ loaded->num_bins++ ] = bin;
+}
+
+/// Event Queue
+
+static unsigned int ds_event_queue_average (
+  unsigned int                  average,
+  unsigned int                  sample
+)
+{
+  /// exponentially weighted moving average, scaled by 2^DS_EVENT_QUEUE_COST_SHIFT
+  return average - ( average >> DS_EVENT_QUEUE_COST_SHIFT ) + sample;
+}
+
+static unsigned int ds_event_calendar_index (
+  struct ds_event_calendar *    self,
+  unsigned int                  time
+)
+{
+  return ( time / self->width ) & ( self->num_buckets - 1U );
+}
+
+static struct ds_event_bin * ds_event_calendar_find_min (
+  struct ds_event_calendar *    self,
+  unsigned int                  time,
+  unsigned int *                num_steps
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->buckets);
+
+  /// all bins are at or after `time`: walk one year of buckets starting there
+  unsigned int        index = ds_event_calendar_index(self, time);
+  unsigned long long  top   = ( (unsigned long long)( time / self->width ) + 1ULL )
+    * self->width;
+
+  for ( unsigned int step = 0U; step < self->num_buckets; ++step ) {
+    struct ds_event_bin * bin = self->buckets[ index ].head;
+
+    if ( NULL != (void *)bin && bin->time < top )
+      return bin;
+
+    index = ( index + 1U ) & ( self->num_buckets - 1U );
+    top  += self->width;
+    ++*num_steps;
+  }
+
+  /// the next bin is more than one year ahead, then search directly
+  struct ds_event_bin * min_bin = (struct ds_event_bin *)NULL;
+
+  for ( index = 0U; index < self->num_buckets; ++index ) {
+    struct ds_event_bin * bin = self->buckets[ index ].head;
+
+    if ( NULL == (void *)bin )
+      continue;
+
+    if ( NULL == (void *)min_bin || bin->time < min_bin->time ) {
+      min_bin = bin;
+    }
+  }
+
+  return min_bin;
+}
+
+static bool ds_event_queue_insert_list (
+  struct ds_event_queue *       self,
+  struct ds_event *             event,
+  bool                          is_front
+)
+{
+  unsigned int          time      = event->time;
+  unsigned int          num_steps = 0U;
+  struct ds_event_bin * curr      = self->head;
+  struct ds_event_bin * prev      = (struct ds_event_bin *)NULL;
+
+  if ( NULL != (void *)self->tail && time > self->tail->time ) {
+    /// appending past the tail does not need a scan
+    prev  = self->tail;
+    curr  = (struct ds_event_bin *)NULL;
+  }
+
+  while ( NULL != (void *)curr ) {
+    if ( time <= curr->time )
+      break;
+
+    prev  = curr;
+    curr  = curr->next;
+    ++num_steps;
+  }
+
+  self->stats.list_cost = ds_event_queue_average(self->stats.list_cost, num_steps);
+
+  if ( NULL != (void *)curr && time == curr->time ) {
+    if ( is_front ) {
+      ds_event_bin_insert_front(curr, event);
+    } else {
+      ds_event_bin_insert(curr, event);
+    }
+
+    return true;
+  }
+
+  /// no bin has been found, then acquire a new one
+  struct ds_event_bin * bin = ds_event_bin_pool_acquire(&self->bins,
+    event,
+    self->is_grouped
+  );
+
+  if ( NULL == (void *)bin )
+    return false;
+
+  bin->next = curr;
+
+  if ( NULL == (void *)prev ) {
+    self->head  = bin;
+  } else {
+    prev->next  = bin;
+  }
+
+  if ( NULL == (void *)curr ) {
+    self->tail  = bin;
+  }
+
+  ++self->num_bins;
+  return true;
+}
+
+static bool ds_event_queue_insert_calendar (
+  struct ds_event_queue *       self,
+  struct ds_event *             event,
+  bool                          is_front
+)
+{
+  struct ds_event_calendar *  calendar  = &self->calendar;
+  unsigned int                time      = event->time;
+  unsigned int                num_steps = 0U;
+  struct ds_event_bucket *    bucket    = calendar->buckets
+    + ds_event_calendar_index(calendar, time);
+  struct ds_event_bin *       curr      = bucket->head;
+  struct ds_event_bin *       prev      = (struct ds_event_bin *)NULL;
+
+  if ( NULL != (void *)bucket->tail && time > bucket->tail->time ) {
+    prev  = bucket->tail;
+    curr  = (struct ds_event_bin *)NULL;
+  }
+
+  while ( NULL != (void *)curr ) {
+    if ( time <= curr->time )
+      break;
+
+    prev  = curr;
+    curr  = curr->next;
+    ++num_steps;
+  }
+
+  self->stats.calendar_cost = ds_event_queue_average(self->stats.calendar_cost, num_steps);
+
+  if ( NULL != (void *)curr && time == curr->time ) {
+    if ( is_front ) {
+      ds_event_bin_insert_front(curr, event);
+    } else {
+      ds_event_bin_insert(curr, event);
+    }
+
+    return true;
+  }
+
+  struct ds_event_bin * bin = ds_event_bin_pool_acquire(&self->bins,
+    event,
+    self->is_grouped
+  );
+
+  if ( NULL == (void *)bin )
+    return false;
+
+  bin->next = curr;
+
+  if ( NULL == (void *)prev ) {
+    bucket->head  = bin;
+  } else {
+    prev->next    = bin;
+  }
+
+  if ( NULL == (void *)curr ) {
+    bucket->tail  = bin;
+  }
+
+  /// the head always caches the earliest bin
+  if ( NULL == (void *)self->head || time < self->head->time ) {
+    self->head  = bin;
+  }
+
+  if ( time > calendar->max_time ) {
+    calendar->max_time  = time;
+  }
+
+  ++self->num_bins;
+  return true;
+}
+
+static bool ds_event_queue_link (
+  struct ds_event_queue *       self,
+  struct ds_event *             event,
+  bool                          is_front
+)
+{
+  bool is_okay;
+
+  switch ( self->kind ) {
+  case DS_EVENT_QUEUE_KIND_LIST:
+    is_okay = ds_event_queue_insert_list(self, event, is_front);
+    break;
+
+  case DS_EVENT_QUEUE_KIND_CALENDAR:
+    is_okay = ds_event_queue_insert_calendar(self, event, is_front);
+    break;
+
+  default:
+    UNREACHABLE();
+  }
+
+  if ( !is_okay )
+    return is_okay;
+
+  ++self->num_events;
+  ++self->stats.num_operations;
+
+  return true;
+}
+
+static void ds_event_queue_remove_head (
+  struct ds_event_queue *       self
+)
+{
+  struct ds_event_bin * bin = self->head;
+
+  switch ( self->kind ) {
+  case DS_EVENT_QUEUE_KIND_LIST: {
+    self->head  = bin->next;
+
+    if ( NULL == (void *)self->head ) {
+      self->tail  = self->head;
+    }
+  } break;
+
+  case DS_EVENT_QUEUE_KIND_CALENDAR: {
+    struct ds_event_calendar *  calendar  = &self->calendar;
+    struct ds_event_bucket *    bucket    = calendar->buckets
+      + ds_event_calendar_index(calendar, bin->time);
+
+    /// the earliest bin is necessarily the first one of its bucket
+    assert(bin == bucket->head);
+    bucket->head  = bin->next;
+
+    if ( NULL == (void *)bucket->head ) {
+      bucket->tail  = bucket->head;
+    }
+
+    /// sampled apart: the search is paid once per bin, not once per event
+    unsigned int num_steps  = 0U;
+    self->head  = ds_event_calendar_find_min(calendar, bin->time, &num_steps);
+    self->stats.find_cost = ds_event_queue_average(self->stats.find_cost, num_steps);
+  } break;
+
+  default:
+    UNREACHABLE();
+  }
+
+  bin->next = (struct ds_event_bin *)NULL;
+  --self->num_bins;
+}
+
+static struct ds_event_bin * ds_event_queue_detach (
+  struct ds_event_queue *       self
+)
+{
+  /// unlink all the bins as a single time-ordered chain
+  struct ds_event_bin * head  = (struct ds_event_bin *)NULL;
+  struct ds_event_bin * tail  = (struct ds_event_bin *)NULL;
+
+  switch ( self->kind ) {
+  case DS_EVENT_QUEUE_KIND_LIST: {
+    head  = self->head;
+  } break;
+
+  case DS_EVENT_QUEUE_KIND_CALENDAR: {
+    unsigned int num_bins = self->num_bins;
+
+    while ( NULL != (void *)self->head ) {
+      struct ds_event_bin * bin = self->head;
+
+      ds_event_queue_remove_head(self);
+
+      if ( NULL == (void *)tail ) {
+        head  = bin;
+      } else {
+        tail->next  = bin;
+      }
+
+      tail  = bin;
+    }
+
+    self->num_bins  = num_bins;
+  } break;
+
+  default:
+    UNREACHABLE();
+  }
+
+  self->head  = (struct ds_event_bin *)NULL;
+  self->tail  = (struct ds_event_bin *)NULL;
+
+  return head;
+}
+
+static void ds_event_queue_attach (
+  struct ds_event_queue *       self,
+  enum ds_event_queue_kind      kind,
+  struct ds_event_bin *         bins
+)
+{
+  self->kind  = kind;
+
+  switch ( kind ) {
+  case DS_EVENT_QUEUE_KIND_LIST: {
+    self->head  = bins;
+    self->tail  = bins;
+
+    while ( NULL != (void *)self->tail && NULL != (void *)self->tail->next ) {
+      self->tail  = self->tail->next;
+    }
+  } break;
+
+  case DS_EVENT_QUEUE_KIND_CALENDAR: {
+    struct ds_event_calendar * calendar = &self->calendar;
+
+    /// one bucket per bin, each about three mean separations wide
+    unsigned int num_buckets  = DS_EVENT_CALENDAR_MIN_BUCKETS;
+
+    while ( num_buckets < self->num_bins && num_buckets < calendar->max_buckets ) {
+      num_buckets <<= 1U;
+    }
+
+    unsigned int  num_samples = 0U;
+    unsigned int  last_time   = NULL == (void *)bins ? 0U : bins->time;
+
+    for ( struct ds_event_bin * bin = bins; NULL != (void *)bin; bin = bin->next ) {
+      if ( num_samples < DS_EVENT_CALENDAR_MIN_BINS ) {
+        last_time = bin->time;
+        ++num_samples;
+      }
+
+      calendar->max_time  = bin->time;
+    }
+
+    unsigned long long width  = 1ULL;
+
+    if ( 1U < num_samples ) {
+      width = 3ULL * ( last_time - bins->time ) / ( num_samples - 1U );
+      width = width < 1ULL ? 1ULL : width > UINT_MAX ? UINT_MAX : width;
+    }
+
+    calendar->num_buckets = num_buckets;
+    calendar->width       = (unsigned int)width;
+
+    for ( unsigned int index = 0U; index < num_buckets; ++index ) {
+      calendar->buckets[ index ].head = (struct ds_event_bin *)NULL;
+      calendar->buckets[ index ].tail = (struct ds_event_bin *)NULL;
+    }
+
+    /// bins arrive in time order, so appending keeps every bucket sorted
+    while ( NULL != (void *)bins ) {
+      struct ds_event_bin *     bin     = bins;
+      struct ds_event_bucket *  bucket  = calendar->buckets
+        + ds_event_calendar_index(calendar, bin->time);
+
+      bins      = bin->next;
+      bin->next = (struct ds_event_bin *)NULL;
+
+      if ( NULL == (void *)bucket->tail ) {
+        bucket->head  = bin;
+      } else {
+        bucket->tail->next  = bin;
+      }
+
+      bucket->tail  = bin;
+
+      if ( NULL == (void *)self->head ) {
+        self->head  = bin;
+      }
+    }
+  } break;
+
+  default:
+    UNREACHABLE();
+  }
+}
+
+static void ds_event_queue_migrate (
+  struct ds_event_queue *       self,
+  enum ds_event_queue_kind      kind,
+  unsigned int                  cost
+)
+{
+  struct ds_event_bin * bins  = ds_event_queue_detach(self);
+
+  ds_event_queue_attach(self, kind, bins);
+
+  /// seed the new structure with the estimate that motivated the migration
+  self->stats.list_cost       = cost;
+  self->stats.calendar_cost   = 0U;
+  self->stats.find_cost       = 0U;
+  self->stats.num_operations  = 0U;
+  ++self->stats.num_migrations;
+}
+
+/// back to the list and the estimates of a fresh queue, once drained; the
+/// buckets of an adaptive queue stay allocated
+static void ds_event_queue_reset (
+  struct ds_event_queue *       self
+)
+{
+  assert(NULL == (void *)self->head);
+
+  self->kind                  = DS_EVENT_QUEUE_KIND_LIST;
+  self->tail                  = (struct ds_event_bin *)NULL;
+  self->calendar.num_buckets  = 0U;
+  self->calendar.width        = 0U;
+  self->calendar.max_time     = 0U;
+
+  memset(&self->stats, 0, sizeof(self->stats));
+}
+
+static void ds_event_queue_adapt (
+  struct ds_event_queue *       self
+)
+{
+  struct ds_event_queue_stats * stats = &self->stats;
+
+  /// hysteresis: amortize the previous migration before considering another
+  if ( stats->num_operations < self->num_bins
+    || stats->num_operations < DS_EVENT_QUEUE_ADAPT_PERIOD )
+    return;
+
+  unsigned int high_cost  = DS_EVENT_QUEUE_HIGH_COST << DS_EVENT_QUEUE_COST_SHIFT;
+  unsigned int low_cost   = DS_EVENT_QUEUE_LOW_COST << DS_EVENT_QUEUE_COST_SHIFT;
+
+  switch ( self->kind ) {
+  case DS_EVENT_QUEUE_KIND_LIST: {
+    if ( DS_EVENT_CALENDAR_MIN_BINS <= self->num_bins
+      && high_cost < stats->list_cost ) {
+      ds_event_queue_migrate(self, DS_EVENT_QUEUE_KIND_CALENDAR, stats->list_cost);
+    }
+  } break;
+
+  case DS_EVENT_QUEUE_KIND_CALENDAR: {
+    struct ds_event_calendar * calendar = &self->calendar;
+
+    /// a sorted list insertion would visit the bins before the mean offset
+    unsigned long long span     = NULL == (void *)self->head ? 1ULL
+      : (unsigned long long)calendar->max_time - self->head->time + 1ULL;
+    unsigned long long offset   = ( stats->mean_offset >> DS_EVENT_QUEUE_COST_SHIFT ) < span
+      ? ( stats->mean_offset >> DS_EVENT_QUEUE_COST_SHIFT ) : span;
+    unsigned int       list_cost = (unsigned int)(
+      ( ( (unsigned long long)self->num_bins * offset / span ) << DS_EVENT_QUEUE_COST_SHIFT )
+    );
+
+    /// per event, the search for the next bin is shared by the pending events
+    /// of the bin: the fuller the bins, the cheaper the calendar
+    unsigned long long occupancy      = 0U == self->num_bins ? 1ULL
+      : ( (unsigned long long)self->num_events + self->num_bins - 1U ) / self->num_bins;
+    unsigned long long calendar_cost  = stats->calendar_cost
+      + stats->find_cost / ( 0ULL == occupancy ? 1ULL : occupancy );
+
+    if ( self->num_bins < DS_EVENT_CALENDAR_MIN_BINS / 2U
+      || list_cost < low_cost
+      || list_cost < calendar_cost ) {
+      ds_event_queue_migrate(self, DS_EVENT_QUEUE_KIND_LIST, list_cost);
+      break;
+    }
+
+    bool is_too_small = calendar->num_buckets < calendar->max_buckets
+      && 2U * calendar->num_buckets < self->num_bins;
+    bool is_too_large = DS_EVENT_CALENDAR_MIN_BUCKETS < calendar->num_buckets
+      && 4U * self->num_bins < calendar->num_buckets;
+
+    /// resize, or re-estimate the bucket width when buckets are poorly balanced
+    if ( is_too_small || is_too_large || high_cost < calendar_cost ) {
+      ds_event_queue_migrate(self, DS_EVENT_QUEUE_KIND_CALENDAR, list_cost);
+    }
+  } break;
+
+  default:
+    UNREACHABLE();
+  }
+}
+
+bool ds_event_queue_initialize (
+  struct ds_event_queue *       self,
+  unsigned int                  max_events,
+  unsigned int                  max_bins,
+  enum ds_memory_flags          flags
+)
+{
+  assert(NULL != (void *)self);
+
+  bool is_okay;
+
+  is_okay = ds_event_pool_initialize(&self->events, max_events, flags);
+
+  if ( !is_okay )
+    return is_okay;
+
+  is_okay = ds_event_bin_pool_initialize(&self->bins, max_bins, flags);
+
+  if ( !is_okay ) {
+    ds_event_pool_deinitialize(&self->events);
+    return is_okay;
+  }
+
+  self->head        = (struct ds_event_bin *)NULL;
+  self->tail        = (struct ds_event_bin *)NULL;
+  self->kind        = DS_EVENT_QUEUE_KIND_LIST;
+  self->is_adaptive = false;
+  self->is_grouped  = false;
+  self->num_events  = 0U;
+  self->num_bins    = 0U;
+
+  memset(&self->calendar, 0, sizeof(self->calendar));
+  memset(&self->stats, 0, sizeof(self->stats));
+
+  return true;
+}
+
+void ds_event_queue_deinitialize (
+  struct ds_event_queue *       self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL == (void *)self->head);
+  assert(NULL == (void *)self->tail);
+
+  free(self->calendar.buckets);
+
+  ds_event_bin_pool_deinitialize(&self->bins);
+  ds_event_pool_deinitialize(&self->events);
+}
+
+bool ds_event_queue_enqueue (
+  struct ds_event_queue *       self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+
+  struct ds_event * event = ds_event_pool_acquire(&self->events,
+    time,
+    type,
+    data
+  );
+
+  if ( NULL == (void *)event )
+    return false;
+
+  bool is_okay  = ds_event_queue_insert(self, event);
+
+  if ( !is_okay ) {
+    ds_event_pool_release(&self->events, event);
+  }
+
+  return is_okay;
+}
+
+bool ds_event_queue_insert (
+  struct ds_event_queue *       self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+  assert(NULL == (void *)event->next);
+
+  return ds_event_queue_link(self, event, false);
+}
+
+struct ds_event * ds_event_queue_dequeue (
+  struct ds_event_queue *       self,
+  unsigned int                  time_limit
+)
+{
+  assert(NULL != (void *)self);
+
+  struct ds_event_bin * bin = self->head;
+
+  if ( NULL == (void *)bin || time_limit <= bin->time )
+    return (struct ds_event *)NULL;
+
+  struct ds_event * event = ds_event_bin_remove(bin);
+  /// if the bin is present, it cannot be empty
+  assert(NULL != (void *)event);
+
+  if ( ds_event_bin_is_empty(bin) ) {
+    ds_event_queue_remove_head(self);
+    ds_event_bin_pool_release(&self->bins, bin);
+  }
+
+  --self->num_events;
+  ++self->stats.num_operations;
+
+  return event;
+}
+
+struct ds_event * ds_event_queue_peek (
+  struct ds_event_queue *       self,
+  unsigned int                  time_limit
+)
+{
+  assert(NULL != (void *)self);
+
+  struct ds_event_bin * bin = self->head;
+
+  if ( NULL == (void *)bin || time_limit <= bin->time )
+    return (struct ds_event *)NULL;
+
+  return ds_event_bin_peek(bin);
+}
+
+void ds_event_queue_prefetch (
+  struct ds_event_queue *       self
+)
+{
+  assert(NULL != (void *)self);
+
+  struct ds_event_bin * bin = self->head;
+
+  if ( NULL == (void *)bin )
+    return;
+
+  switch ( self->kind ) {
+  case DS_EVENT_QUEUE_KIND_LIST:
+    PREFETCH(bin->next);
+    break;
+
+  case DS_EVENT_QUEUE_KIND_CALENDAR: {
+    struct ds_event_calendar *  calendar  = &self->calendar;
+    unsigned int                index     = ds_event_calendar_index(calendar, bin->time);
+    unsigned long long          top       = ( (unsigned long long)( bin->time / calendar->width ) + 1ULL )
+      * calendar->width;
+
+    if ( NULL != (void *)bin->next && bin->next->time < top ) {
+      PREFETCH(bin->next);
+      break;
+    }
+
+    for ( unsigned int step = 1U; step < calendar->num_buckets && step <= DS_EVENT_QUEUE_PREFETCH_SPAN; ++step ) {
+      struct ds_event_bin * next  = calendar->buckets[
+        ( index + step ) & ( calendar->num_buckets - 1U )
+      ].head;
+
+      if ( NULL != (void *)next ) {
+        PREFETCH(next);
+        break;
+      }
+    }
+  } break;
+
+  default:
+    UNREACHABLE();
+  }
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    PREFETCH(bin->events[ type ].head);
+  }
+}
+
+void ds_event_queue_recycle (
+  struct ds_event_queue *       self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+
+  ds_event_pool_release(&self->events, event);
+}
+
+bool ds_event_queue_requeue (
+  struct ds_event_queue *       self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+  assert(NULL == (void *)event->next);
+
+  return ds_event_queue_link(self, event, true);
+}
+
+bool ds_event_queue_is_empty (
+  struct ds_event_queue *       self
+)
+{
+  assert(NULL != (void *)self);
+
+  return NULL == (void *)self->head;
+}
+
+bool ds_event_queue_set_adaptive (
+  struct ds_event_queue *       self,
+  bool                          is_adaptive
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( is_adaptive && NULL == (void *)self->calendar.buckets ) {
+    unsigned int max_buckets  = DS_EVENT_CALENDAR_MIN_BUCKETS;
+
+    while ( max_buckets < self->bins.max_bins && max_buckets <= UINT_MAX / 2U ) {
+      max_buckets <<= 1U;
+    }
+
+    struct ds_event_bucket * buckets
+      = (struct ds_event_bucket *)malloc(
+        (size_t)max_buckets * sizeof(*buckets)
+      );
+
+    if ( NULL == (void *)buckets ) {
+      ERROR("Cannot allocate %u buckets: %s.",
+        max_buckets,
+        strerror(errno)
+      );
+      return false;
+    }
+
+    self->calendar.buckets      = buckets;
+    self->calendar.max_buckets  = max_buckets;
+  }
+
+  if ( !is_adaptive && DS_EVENT_QUEUE_KIND_LIST != self->kind ) {
+    ds_event_queue_migrate(self, DS_EVENT_QUEUE_KIND_LIST, 0U);
+  }
+
+  self->is_adaptive = is_adaptive;
+  return true;
+}
+
+void ds_event_queue_sample (
+  struct ds_event_queue *       self,
+  unsigned int                  offset
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( !self->is_adaptive )
+    return;
+
+  struct ds_event_queue_stats * stats = &self->stats;
+
+  stats->mean_offset  = stats->mean_offset
+    - ( stats->mean_offset >> DS_EVENT_QUEUE_COST_SHIFT ) + offset;
+
+  if ( 0U == ++stats->num_samples % DS_EVENT_QUEUE_ADAPT_PERIOD ) {
+    ds_event_queue_adapt(self);
+  }
+}
+
+enum ds_event_queue_kind ds_event_queue_get_kind (
+  struct ds_event_queue *       self
+)
+{
+  assert(NULL != (void *)self);
+
+  return self->kind;
+}
+
+unsigned int ds_event_queue_get_num_migrations (
+  struct ds_event_queue *       self
+)
+{
+  assert(NULL != (void *)self);
+
+  return self->stats.num_migrations;
+}
+
+bool ds_event_queue_set_grouped (
+  struct ds_event_queue *       self,
+  bool                          is_grouped
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( !ds_event_queue_is_empty(self) ) {
+    ERROR("Invalid state: %s.",
+      "Cannot change the grouping of a non-empty queue"
+    );
+    return false;
+  }
+
+  self->is_grouped  = is_grouped;
+  return true;
+}
+
+/// Event Skip List
+
+static bool ds_event_skipnode_is_marked (
+  uintptr_t                     next
+)
+{
+  return 0U != ( next & (uintptr_t)1U );
+}
+
+static struct ds_event_skipnode * ds_event_skipnode_unmark (
+  uintptr_t                     next
+)
+{
+  return (struct ds_event_skipnode *)( next & ~(uintptr_t)1U );
+}
+
+static bool ds_event_skipnode_is_before (
+  struct ds_event_skipnode *    self,
+  unsigned int                  time,
+  unsigned long long            sequence
+)
+{
+  return self->event.time < time
+    || ( self->event.time == time && self->sequence < sequence );
+}
+
+static uintptr_t ds_event_skipnode_next (
+  struct ds_event_skipnode *    self,
+  unsigned int                  level
+)
+{
+  return atomic_load(self->next + level);
+}
+
+static void ds_event_skiplist_push (
+  struct ds_event_skiplist *    self,
+  struct ds_event_skipnode *    first,
+  struct ds_event_skipnode *    last
+)
+{
+  /// Treiber stack of node indices, tagged against ABA
+  unsigned long long top  = atomic_load(&self->free_top);
+  unsigned long long next;
+
+  do {
+    atomic_store(&last->free_next, (unsigned int)top);
+    next  = ( ( ( top >> 32U ) + 1ULL ) << 32U )
+      | (unsigned long long)( first - self->nodes + 1 );
+  } while ( !atomic_compare_exchange_weak(&self->free_top, &top, next) );
+}
+
+static struct ds_event_skipnode * ds_event_skiplist_pop (
+  struct ds_event_skiplist *    self
+)
+{
+  unsigned long long top  = atomic_load(&self->free_top);
+  unsigned long long next;
+  struct ds_event_skipnode * node;
+
+  do {
+    unsigned int index  = (unsigned int)top;
+
+    if ( 0U == index )
+      return (struct ds_event_skipnode *)NULL;
+
+    node  = self->nodes + index - 1U;
+    next  = ( ( ( top >> 32U ) + 1ULL ) << 32U )
+      | (unsigned long long)atomic_load(&node->free_next);
+  } while ( !atomic_compare_exchange_weak(&self->free_top, &top, next) );
+
+  return node;
+}
+
+static void ds_event_skiplist_enter (
+  struct ds_event_skiplist_thread * self
+)
+{
+  struct ds_event_skiplist * list = self->list;
+
+  unsigned long long epoch  = atomic_load(&list->epoch);
+  atomic_store(&self->epoch, epoch);
+
+  /// nodes retired two epochs ago cannot be referenced anymore
+  for ( unsigned int index = 0U; index < 3U; ++index ) {
+    struct ds_event_skipnode * node = self->retired[ index ];
+
+    if ( NULL == (void *)node || self->retired_epochs[ index ] + 2ULL > epoch )
+      continue;
+
+    while ( NULL != (void *)node ) {
+      struct ds_event_skipnode * link = node->link;
+
+      node->link      = self->free_node;
+      self->free_node = node;
+      ++self->num_free;
+      --self->num_retired;
+      node            = link;
+    }
+
+    self->retired[ index ]  = (struct ds_event_skipnode *)NULL;
+  }
+}
+
+static void ds_event_skiplist_leave (
+  struct ds_event_skiplist_thread * self
+)
+{
+  atomic_store(&self->epoch, DS_EVENT_SKIPLIST_QUIESCENT);
+}
+
+static void ds_event_skiplist_advance (
+  struct ds_event_skiplist *    self
+)
+{
+  unsigned long long epoch  = atomic_load(&self->epoch);
+
+  for ( unsigned int index = 0U; index < DS_EVENT_SKIPLIST_MAX_THREADS; ++index ) {
+    unsigned long long announced  = atomic_load(&self->threads[ index ].epoch);
+
+    if ( DS_EVENT_SKIPLIST_QUIESCENT != announced && epoch != announced )
+      return;
+  }
+
+  atomic_compare_exchange_strong(&self->epoch, &epoch, epoch + 1ULL);
+}
+
+static void ds_event_skiplist_retire (
+  struct ds_event_skiplist_thread * self,
+  struct ds_event_skipnode *    node
+)
+{
+  /// tag with the global epoch observed after the node has been unlinked
+  unsigned long long epoch  = atomic_load(&self->list->epoch);
+  unsigned int       index  = (unsigned int)( epoch % 3ULL );
+
+  assert(NULL == (void *)self->retired[ index ]
+    || epoch == self->retired_epochs[ index ]);
+
+  node->link                    = self->retired[ index ];
+  self->retired[ index ]        = node;
+  self->retired_epochs[ index ] = epoch;
+  ++self->num_retired;
+}
+
+static void ds_event_skiplist_trim (
+  struct ds_event_skiplist_thread * self
+)
+{
+  if ( self->num_free <= 2U * DS_EVENT_SKIPLIST_CACHE_SIZE )
+    return;
+
+  /// give a cache worth of nodes back to the other threads
+  struct ds_event_skipnode * first  = self->free_node;
+  struct ds_event_skipnode * last   = first;
+
+  for ( unsigned int index = 1U; index < DS_EVENT_SKIPLIST_CACHE_SIZE; ++index ) {
+    atomic_store(&last->free_next, (unsigned int)( last->link - self->list->nodes + 1 ));
+    last  = last->link;
+  }
+
+  self->free_node  = last->link;
+  self->num_free  -= DS_EVENT_SKIPLIST_CACHE_SIZE;
+  last->link       = (struct ds_event_skipnode *)NULL;
+
+  ds_event_skiplist_push(self->list, first, last);
+}
+
+static struct ds_event_skipnode * ds_event_skiplist_locate (
+  struct ds_event_skiplist *    self,
+  unsigned int                  time,
+  unsigned long long            sequence,
+  struct ds_event_skipnode **   preds,
+  struct ds_event_skipnode **   succs
+)
+{
+  struct ds_event_skipnode * pred     = self->head;
+  struct ds_event_skipnode * deleted  = (struct ds_event_skipnode *)NULL;
+
+  for ( unsigned int level = DS_EVENT_SKIPLIST_MAX_LEVEL; 0U < level--; ) {
+    uintptr_t                  next         = ds_event_skipnode_next(pred, level);
+    bool                       is_deleted   = ds_event_skipnode_is_marked(next);
+    struct ds_event_skipnode * curr         = ds_event_skipnode_unmark(next);
+
+    /// skip the deleted prefix as well as the earlier nodes
+    while ( ( curr != self->tail && ds_event_skipnode_is_before(curr, time, sequence) )
+      || ds_event_skipnode_is_marked(ds_event_skipnode_next(curr, 0U))
+      || ( 0U == level && is_deleted ) ) {
+      if ( 0U == level && is_deleted ) {
+        deleted = curr;
+      }
+
+      pred        = curr;
+      next        = ds_event_skipnode_next(pred, level);
+      is_deleted  = ds_event_skipnode_is_marked(next);
+      curr        = ds_event_skipnode_unmark(next);
+    }
+
+    preds[ level ]  = pred;
+    succs[ level ]  = curr;
+  }
+
+  return deleted;
+}
+
+static void ds_event_skiplist_restructure (
+  struct ds_event_skiplist *    self
+)
+{
+  /// unlink the deleted prefix from the upper levels of the head
+  struct ds_event_skipnode * pred   = self->head;
+  unsigned int               level  = DS_EVENT_SKIPLIST_MAX_LEVEL - 1U;
+
+  while ( 0U < level ) {
+    uintptr_t                  head = ds_event_skipnode_next(self->head, level);
+    struct ds_event_skipnode * curr = ds_event_skipnode_unmark(ds_event_skipnode_next(pred, level));
+
+    if ( !ds_event_skipnode_is_marked(ds_event_skipnode_next(ds_event_skipnode_unmark(head), 0U)) ) {
+      --level;
+      continue;
+    }
+
+    while ( ds_event_skipnode_is_marked(ds_event_skipnode_next(curr, 0U)) ) {
+      pred  = curr;
+      curr  = ds_event_skipnode_unmark(ds_event_skipnode_next(pred, level));
+    }
+
+    if ( atomic_compare_exchange_strong(self->head->next + level, &head, (uintptr_t)curr) ) {
+      --level;
+    }
+  }
+}
+
+static void ds_event_skiplist_unlink (
+  struct ds_event_skiplist_thread * self,
+  uintptr_t                     old_head,
+  struct ds_event_skipnode *    new_head
+)
+{
+  /// remove the deleted nodes before `new_head` at once, if no other thread did
+  struct ds_event_skiplist * list = self->list;
+
+  if ( ds_event_skipnode_next(list->head, 0U) != old_head
+    || !atomic_compare_exchange_strong(list->head->next, &old_head, (uintptr_t)new_head | (uintptr_t)1U) )
+    return;
+
+  ds_event_skiplist_restructure(list);
+
+  struct ds_event_skipnode * curr = ds_event_skipnode_unmark(old_head);
+
+  while ( curr != new_head ) {
+    struct ds_event_skipnode * succ = ds_event_skipnode_unmark(ds_event_skipnode_next(curr, 0U));
+
+    ds_event_skiplist_retire(self, curr);
+    curr  = succ;
+  }
+}
+
+static void ds_event_skiplist_collect (
+  struct ds_event_skiplist_thread * self
+)
+{
+  struct ds_event_skiplist * list     = self->list;
+  struct ds_event_skipnode * node     = list->head;
+  struct ds_event_skipnode * new_head = (struct ds_event_skipnode *)NULL;
+  uintptr_t                  old_head = ds_event_skipnode_next(node, 0U);
+  uintptr_t                  next     = old_head;
+
+  /// as a dequeue would, up to the last deleted node or a node being inserted
+  while ( ds_event_skipnode_is_marked(next) ) {
+    if ( NULL == (void *)new_head && atomic_load(&node->is_inserting) ) {
+      new_head  = node;
+    }
+
+    node  = ds_event_skipnode_unmark(next);
+    next  = ds_event_skipnode_next(node, 0U);
+  }
+
+  if ( NULL == (void *)new_head ) {
+    new_head  = node;
+  }
+
+  if ( list->head != new_head && ds_event_skipnode_unmark(old_head) != new_head ) {
+    ds_event_skiplist_unlink(self, old_head, new_head);
+  }
+}
+
+static void ds_event_skiplist_refill (
+  struct ds_event_skiplist_thread * self
+)
+{
+  /// refill the local cache from the shared stack
+  while ( self->num_free < DS_EVENT_SKIPLIST_CACHE_SIZE ) {
+    struct ds_event_skipnode * node = ds_event_skiplist_pop(self->list);
+
+    if ( NULL == (void *)node )
+      break;
+
+    node->link      = self->free_node;
+    self->free_node = node;
+    ++self->num_free;
+  }
+}
+
+static struct ds_event_skipnode * ds_event_skiplist_allocate (
+  struct ds_event_skiplist_thread * self
+)
+{
+  struct ds_event_skiplist * list = self->list;
+
+  if ( NULL == (void *)self->free_node ) {
+    ds_event_skiplist_refill(self);
+  }
+
+  if ( NULL == (void *)self->free_node ) {
+    /// the missing nodes may only be deleted or retired: unlink the deleted
+    /// prefix however short, then wait out the two epochs of the retirement
+    ds_event_skiplist_collect(self);
+
+    for ( unsigned int round = 0U; round < 3U && NULL == (void *)self->free_node; ++round ) {
+      ds_event_skiplist_advance(list);
+      ds_event_skiplist_enter(self);
+
+      if ( NULL == (void *)self->free_node ) {
+        ds_event_skiplist_refill(self);
+      }
+    }
+  }
+
+  struct ds_event_skipnode * node = self->free_node;
+
+  if ( NULL == (void *)node )
+    return node;
+
+  self->free_node = node->link;
+  node->link      = (struct ds_event_skipnode *)NULL;
+  --self->num_free;
+
+  return node;
+}
+
+bool ds_event_skiplist_initialize (
+  struct ds_event_skiplist *    self,
+  unsigned int                  max_events
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == max_events || UINT_MAX - 3U < max_events ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "max_events",
+      "Out of range [1;MAX_UINT-3]"
+    );
+    return false;
+  }
+
+  /// three more nodes: the head and tail sentinels, and the last deleted node,
+  /// which stays linked in front of the first pending one
+  unsigned int max_nodes  = max_events + 3U;
+
+  struct ds_event_skipnode * nodes
+    = (struct ds_event_skipnode *)malloc(
+      (size_t)max_nodes * sizeof(*nodes)
+    );
+
+  if ( NULL == (void *)nodes ) {
+    ERROR("Cannot allocate %u nodes: %s.",
+      max_nodes,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  self->nodes     = nodes;
+  self->max_nodes = max_nodes;
+  self->head      = nodes;
+  self->tail      = nodes + 1;
+
+  atomic_init(&self->free_top, 0ULL);
+  atomic_init(&self->sequence, 0ULL);
+  atomic_init(&self->epoch, 0ULL);
+
+  for ( unsigned int index = 0U; index < max_nodes; ++index ) {
+    struct ds_event_skipnode * node = nodes + index;
+
+    for ( unsigned int level = 0U; level < DS_EVENT_SKIPLIST_MAX_LEVEL; ++level ) {
+      atomic_init(node->next + level, (uintptr_t)( 0U == index ? self->tail : NULL ));
+    }
+
+    atomic_init(&node->is_inserting, false);
+    atomic_init(&node->free_next, 2U <= index && index + 1U < max_nodes ? index + 2U : 0U);
+    node->link      = (struct ds_event_skipnode *)NULL;
+    node->level     = DS_EVENT_SKIPLIST_MAX_LEVEL;
+    node->sequence  = ULLONG_MAX;
+    node->event.time  = UINT_MAX;
+  }
+
+  /// initialize the free stack with the non-sentinel nodes
+  atomic_store(&self->free_top, 2U < max_nodes ? 3ULL : 0ULL);
+
+  for ( unsigned int index = 0U; index < DS_EVENT_SKIPLIST_MAX_THREADS; ++index ) {
+    struct ds_event_skiplist_thread * thread = self->threads + index;
+
+    atomic_init(&thread->epoch, DS_EVENT_SKIPLIST_QUIESCENT);
+    atomic_init(&thread->is_attached, false);
+    thread->list  = self;
+  }
+
+  return true;
+}
+
+void ds_event_skiplist_deinitialize (
+  struct ds_event_skiplist *    self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->nodes);
+
+  for ( unsigned int index = 0U; index < DS_EVENT_SKIPLIST_MAX_THREADS; ++index ) {
+    assert(!atomic_load(&self->threads[ index ].is_attached));
+  }
+
+  free(self->nodes);
+}
+
+struct ds_event_skiplist_thread * ds_event_skiplist_attach (
+  struct ds_event_skiplist *    self
+)
+{
+  assert(NULL != (void *)self);
+
+  for ( unsigned int index = 0U; index < DS_EVENT_SKIPLIST_MAX_THREADS; ++index ) {
+    struct ds_event_skiplist_thread * thread = self->threads + index;
+
+    if ( atomic_exchange(&thread->is_attached, true) )
+      continue;
+
+    thread->free_node   = (struct ds_event_skipnode *)NULL;
+    thread->num_free    = 0U;
+    thread->num_retired = 0U;
+    thread->random      = 0x9E3779B97F4A7C15ULL * ( index + 1ULL );
+
+    for ( unsigned int epoch = 0U; epoch < 3U; ++epoch ) {
+      thread->retired[ epoch ]        = (struct ds_event_skipnode *)NULL;
+      thread->retired_epochs[ epoch ] = 0ULL;
+    }
+
+    return thread;
+  }
+
+  ERROR("Out of memory: Maximum number of threads (%u) has been reached.",
+    DS_EVENT_SKIPLIST_MAX_THREADS
+  );
+  return (struct ds_event_skiplist_thread *)NULL;
+}
+
+void ds_event_skiplist_detach (
+  struct ds_event_skiplist_thread * thread
+)
+{
+  assert(NULL != (void *)thread);
+  assert(atomic_load(&thread->is_attached));
+
+  struct ds_event_skiplist * list = thread->list;
+
+  /// wait for the retired nodes to become reclaimable
+  while ( 0U != thread->num_retired ) {
+    ds_event_skiplist_advance(list);
+    ds_event_skiplist_enter(thread);
+    ds_event_skiplist_leave(thread);
+    CPU_RELAX();
+  }
+
+  if ( NULL != (void *)thread->free_node ) {
+    struct ds_event_skipnode * last = thread->free_node;
+
+    while ( NULL != (void *)last->link ) {
+      atomic_store(&last->free_next, (unsigned int)( last->link - list->nodes + 1 ));
+      last  = last->link;
+    }
+
+    ds_event_skiplist_push(list, thread->free_node, last);
+  }
+
+  thread->free_node = (struct ds_event_skipnode *)NULL;
+  thread->num_free  = 0U;
+
+  atomic_store(&thread->is_attached, false);
+}
+
+bool ds_event_skiplist_enqueue (
+  struct ds_event_skiplist_thread * thread,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)thread);
+  assert(atomic_load(&thread->is_attached));
+
+  struct ds_event_skiplist * list = thread->list;
+
+  ds_event_skiplist_enter(thread);
+
+  struct ds_event_skipnode * node = ds_event_skiplist_allocate(thread);
+
+  if ( NULL == (void *)node ) {
+    ds_event_skiplist_leave(thread);
+    ERROR("Out of memory: Maximum number of events (%u) has been reached.",
+      list->max_nodes - 3U
+    );
+    return false;
+  }
+
+  if ( !ds_event_initialize(&node->event, time, type, data) ) {
+    node->link        = thread->free_node;
+    thread->free_node = node;
+    ++thread->num_free;
+    ds_event_skiplist_leave(thread);
+    return false;
+  }
+
+  /// geometric level distribution, from a per-thread xorshift generator
+  thread->random ^= thread->random << 13U;
+  thread->random ^= thread->random >> 7U;
+  thread->random ^= thread->random << 17U;
+
+  unsigned int level  = 1U + (unsigned int)__builtin_ctzll(
+    thread->random | ( 1ULL << ( DS_EVENT_SKIPLIST_MAX_LEVEL - 1U ) )
+  );
+
+  node->level     = level;
+  node->sequence  = atomic_fetch_add(&list->sequence, 1ULL);
+  atomic_store(&node->is_inserting, true);
+
+  struct ds_event_skipnode * preds [ DS_EVENT_SKIPLIST_MAX_LEVEL ];
+  struct ds_event_skipnode * succs [ DS_EVENT_SKIPLIST_MAX_LEVEL ];
+  struct ds_event_skipnode * deleted;
+
+  do {
+    deleted = ds_event_skiplist_locate(list, time, node->sequence, preds, succs);
+    atomic_store(node->next, (uintptr_t)succs[ 0 ]);
+
+    uintptr_t expected  = (uintptr_t)succs[ 0 ];
+
+    if ( atomic_compare_exchange_strong(preds[ 0 ]->next, &expected, (uintptr_t)node) )
+      break;
+  } while ( true );
+
+  for ( unsigned int index = 1U; index < level; ++index ) {
+    do {
+      atomic_store(node->next + index, (uintptr_t)succs[ index ]);
+
+      /// stop as soon as the node, or its successor, is being deleted
+      if ( ds_event_skipnode_is_marked(ds_event_skipnode_next(node, 0U))
+        || ds_event_skipnode_is_marked(ds_event_skipnode_next(succs[ index ], 0U))
+        || deleted == succs[ index ] )
+        goto inserted;
+
+      uintptr_t expected  = (uintptr_t)succs[ index ];
+
+      if ( atomic_compare_exchange_strong(preds[ index ]->next + index, &expected, (uintptr_t)node) )
+        break;
+
+      deleted = ds_event_skiplist_locate(list, time, node->sequence, preds, succs);
+
+      if ( succs[ 0 ] != node )
+        goto inserted;
+    } while ( true );
+  }
+
+inserted:
+  atomic_store(&node->is_inserting, false);
+  ds_event_skiplist_leave(thread);
+
+  return true;
+}
+
+struct ds_event * ds_event_skiplist_dequeue (
+  struct ds_event_skiplist_thread * thread,
+  unsigned int                  time_limit,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)thread);
+  assert(atomic_load(&thread->is_attached));
+  assert(NULL != (void *)event);
+
+  struct ds_event_skiplist * list = thread->list;
+
+  ds_event_skiplist_enter(thread);
+
+  struct ds_event_skipnode * node       = list->head;
+  struct ds_event_skipnode * new_head   = (struct ds_event_skipnode *)NULL;
+  uintptr_t                  old_head   = ds_event_skipnode_next(list->head, 0U);
+  unsigned int               offset     = 0U;
+  uintptr_t                  next;
+
+  /// walk the deleted prefix, then claim the first node by marking the link
+  do {
+    next  = ds_event_skipnode_next(node, 0U);
+
+    struct ds_event_skipnode * succ = ds_event_skipnode_unmark(next);
+
+    if ( succ == list->tail
+      || ( !ds_event_skipnode_is_marked(next) && time_limit <= succ->event.time ) ) {
+      ds_event_skiplist_leave(thread);
+      return (struct ds_event *)NULL;
+    }
+
+    if ( NULL == (void *)new_head && atomic_load(&node->is_inserting) ) {
+      new_head  = node;
+    }
+
+    if ( !ds_event_skipnode_is_marked(next) ) {
+      next  = atomic_fetch_or(node->next, (uintptr_t)1U);
+    }
+
+    ++offset;
+    node  = ds_event_skipnode_unmark(next);
+  } while ( ds_event_skipnode_is_marked(next) );
+
+  event->next = (struct ds_event *)NULL;
+  event->time = node->event.time;
+  event->type = node->event.type;
+  event->data = node->event.data;
+
+  if ( NULL == (void *)new_head ) {
+    new_head  = node;
+  }
+
+  /// batch the physical removal of the deleted prefix
+  if ( DS_EVENT_SKIPLIST_MAX_OFFSET < offset ) {
+    ds_event_skiplist_unlink(thread, old_head, new_head);
+  }
+
+  ds_event_skiplist_leave(thread);
+
+  if ( DS_EVENT_SKIPLIST_CACHE_SIZE <= thread->num_retired ) {
+    ds_event_skiplist_advance(list);
+  }
+
+  ds_event_skiplist_trim(thread);
+
+  return event;
+}
+
+struct ds_event * ds_event_skiplist_peek (
+  struct ds_event_skiplist_thread * thread,
+  unsigned int                  time_limit,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)thread);
+  assert(atomic_load(&thread->is_attached));
+  assert(NULL != (void *)event);
+
+  struct ds_event_skiplist * list = thread->list;
+
+  ds_event_skiplist_enter(thread);
+
+  struct ds_event_skipnode * node = list->head;
+  uintptr_t                  next = ds_event_skipnode_next(node, 0U);
+
+  /// skip the deleted prefix
+  while ( ds_event_skipnode_is_marked(next) ) {
+    node  = ds_event_skipnode_unmark(next);
+    next  = ds_event_skipnode_next(node, 0U);
+  }
+
+  node  = ds_event_skipnode_unmark(next);
+
+  bool is_found = node != list->tail && node->event.time < time_limit;
+
+  if ( is_found ) {
+    event->next = (struct ds_event *)NULL;
+    event->time = node->event.time;
+    event->type = node->event.type;
+    event->data = node->event.data;
+  }
+
+  ds_event_skiplist_leave(thread);
+
+  return is_found ? event : (struct ds_event *)NULL;
+}
+
+bool ds_event_skiplist_is_empty (
+  struct ds_event_skiplist_thread * thread
+)
+{
+  assert(NULL != (void *)thread);
+  assert(atomic_load(&thread->is_attached));
+
+  struct ds_event_skiplist * list = thread->list;
+
+  ds_event_skiplist_enter(thread);
+
+  struct ds_event_skipnode * node = list->head;
+  uintptr_t                  next = ds_event_skipnode_next(node, 0U);
+
+  /// skip the deleted prefix
+  while ( ds_event_skipnode_is_marked(next) ) {
+    node  = ds_event_skipnode_unmark(next);
+    next  = ds_event_skipnode_next(node, 0U);
+  }
+
+  bool is_empty = ds_event_skipnode_unmark(next) == list->tail;
+
+  ds_event_skiplist_leave(thread);
+
+  return is_empty;
+}
+
+/// Random
+
+# define DS_PHILOX_M0                   0xD2511F53U
+# define DS_PHILOX_M1                   0xCD9E8D57U
+# define DS_PHILOX_W0                   0x9E3779B9U
+# define DS_PHILOX_W1                   0xBB67AE85U
+# define DS_PHILOX_NUM_ROUNDS           10U
+
+/// Philox4x32-10 of the consecutive blocks [counter;counter+num_blocks): the
+/// blocks are independent, so that the loop vectorizes
+static void ds_random_generate (
+  uint64_t                      seed,
+  uint64_t                      stream,
+  uint64_t                      counter,
+  uint32_t *                    words,
+  unsigned int                  num_blocks
+)
+{
+  for ( unsigned int block = 0U; block < num_blocks; ++block ) {
+    uint64_t  position  = counter + block;
+    uint32_t  x0        = (uint32_t)position;
+    uint32_t  x1        = (uint32_t)( position >> 32U );
+    uint32_t  x2        = (uint32_t)stream;
+    uint32_t  x3        = (uint32_t)( stream >> 32U );
+    uint32_t  k0        = (uint32_t)seed;
+    uint32_t  k1        = (uint32_t)( seed >> 32U );
+
+    for ( unsigned int round = 0U; round < DS_PHILOX_NUM_ROUNDS; ++round ) {
+      uint64_t  p0  = (uint64_t)DS_PHILOX_M0 * x0;
+      uint64_t  p1  = (uint64_t)DS_PHILOX_M1 * x2;
+
+      x0  = (uint32_t)( p1 >> 32U ) ^ x1 ^ k0;
+      x1  = (uint32_t)p1;
+      x2  = (uint32_t)( p0 >> 32U ) ^ x3 ^ k1;
+      x3  = (uint32_t)p0;
+
+      k0 += DS_PHILOX_W0;
+      k1 += DS_PHILOX_W1;
+    }
+
+    words[ 4U * block + 0U ]  = x0;
+    words[ 4U * block + 1U ]  = x1;
+    words[ 4U * block + 2U ]  = x2;
+    words[ 4U * block + 3U ]  = x3;
+  }
+}
+
+static void ds_random_refill (
+  struct ds_random *            self
+)
+{
+  ds_random_generate(self->seed,
+    self->stream,
+    self->counter,
+    self->buffer,
+    DS_RANDOM_BUFFER_SIZE / 4U
+  );
+
+  self->counter += DS_RANDOM_BUFFER_SIZE / 4U;
+  self->index    = 0U;
+}
+
+static double ds_random_to_uniform (
+  uint32_t                      high,
+  uint32_t                      low
+)
+{
+  return (double)( ( ( (uint64_t)high << 32U ) | low ) >> 11U ) * 0x1.0p-53;
+}
+
+void ds_random_initialize (
+  struct ds_random *            self,
+  uint64_t                      seed,
+  uint64_t                      stream
+)
+{
+  assert(NULL != (void *)self);
+
+  self->seed    = seed;
+  self->stream  = stream;
+  self->counter = 0U;
+  self->index   = DS_RANDOM_BUFFER_SIZE;
+}
+
+uint32_t ds_random_next (
+  struct ds_random *            self
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( DS_RANDOM_BUFFER_SIZE == self->index ) {
+    ds_random_refill(self);
+  }
+
+  return self->buffer[ self->index++ ];
+}
+
+double ds_random_uniform (
+  struct ds_random *            self
+)
+{
+  assert(NULL != (void *)self);
+
+  uint32_t high = ds_random_next(self);
+  uint32_t low  = ds_random_next(self);
+
+  return ds_random_to_uniform(high, low);
+}
+
+double ds_random_exponential (
+  struct ds_random *            self,
+  double                        mean
+)
+{
+  assert(NULL != (void *)self);
+
+  /// 1-u is in (0;1]: never log(0)
+  return -mean * log(1.0 - ds_random_uniform(self));
+}
+
+void ds_random_fill_uniform (
+  struct ds_random *            self,
+  double *                      values,
+  size_t                        num_values
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)values || 0U == num_values);
+
+  size_t index  = 0U;
+
+  while ( index < num_values ) {
+    if ( DS_RANDOM_BUFFER_SIZE == self->index ) {
+      ds_random_refill(self);
+    }
+
+    /// a single word left straddles the refill
+    if ( DS_RANDOM_BUFFER_SIZE - 1U == self->index ) {
+      values[ index++ ] = ds_random_uniform(self);
+      continue;
+    }
+
+    size_t          num_available = ( DS_RANDOM_BUFFER_SIZE - self->index ) / 2U;
+    size_t          num_converted = num_values - index < num_available
+      ? num_values - index : num_available;
+    uint32_t const *  words       = self->buffer + self->index;
+
+    for ( size_t value = 0U; value < num_converted; ++value ) {
+      values[ index + value ] = ds_random_to_uniform(words[ 2U * value ], words[ 2U * value + 1U ]);
+    }
+
+    index       += num_converted;
+    self->index += 2U * (unsigned int)num_converted;
+  }
+}
+
+void ds_random_fill_exponential (
+  struct ds_random *            self,
+  double *                      values,
+  size_t                        num_values,
+  double                        mean
+)
+{
+  assert(NULL != (void *)self);
+
+  ds_random_fill_uniform(self, values, num_values);
+
+  for ( size_t index = 0U; index < num_values; ++index ) {
+    values[ index ] = -mean * log(1.0 - values[ index ]);
+  }
+}
+
+/// Pipeline
+
+/// moves the next events of the step into the ring, up to its depth; split,
+/// under the lock
+static unsigned int ds_pipeline_prepare (
+  struct ds_pipeline *          self
+)
+{
+  /// sequentially consistent, against ds_pipeline_wake()
+  unsigned int head       = atomic_load(&self->head);
+  unsigned int tail       = atomic_load_explicit(&self->tail, memory_order_relaxed);
+  unsigned int num_events = 0U;
+
+  while ( tail - head < self->depth ) {
+    struct ds_event * event = ds_event_queue_dequeue(self->queue, self->time_limit);
+
+    if ( NULL == (void *)event )
+      break;
+
+    PREFETCH(event->data);
+
+    self->events[ tail % DS_PIPELINE_MAX_DEPTH ] = event;
+    ++tail;
+    ++num_events;
+  }
+
+  if ( 0U < num_events ) {
+    ds_event_queue_prefetch(self->queue);
+    atomic_store_explicit(&self->tail, tail, memory_order_release);
+  }
+
+  return num_events;
+}
+
+/// requeues, latest first, the prepared events that would be dequeued after
+/// an event scheduled at `time`; split, under the lock
+static bool ds_pipeline_reclaim (
+  struct ds_pipeline *          self,
+  unsigned int                  time,
+  enum ds_event_type            type
+)
+{
+  unsigned int head = atomic_load_explicit(&self->head, memory_order_relaxed);
+  unsigned int tail = atomic_load_explicit(&self->tail, memory_order_relaxed);
+  bool         is_okay  = true;
+
+  while ( head != tail ) {
+    struct ds_event * event = self->events[ ( tail - 1U ) % DS_PIPELINE_MAX_DEPTH ];
+
+    bool is_after = time < event->time
+      || ( self->queue->is_grouped && time == event->time && type < event->type );
+
+    if ( !is_after )
+      break;
+
+    is_okay = ds_event_queue_requeue(self->queue, event);
+
+    if ( !is_okay )
+      break;
+
+    --tail;
+    ++self->num_requeues;
+  }
+
+  atomic_store_explicit(&self->tail, tail, memory_order_release);
+
+  return is_okay;
+}
+
+static bool ds_pipeline_insert (
+  struct ds_pipeline *          self,
+  struct ds_event *             event,
+  unsigned int                  offset
+)
+{
+  if ( self->is_split ) {
+    pthread_mutex_lock(&self->lock);
+  }
+
+  bool is_okay  = ds_pipeline_reclaim(self, event->time, event->type)
+    && ds_event_queue_insert(self->queue, event);
+
+  if ( is_okay ) {
+    ds_event_queue_sample(self->queue, offset);
+  }
+
+  if ( self->is_split ) {
+    if ( atomic_exchange(&self->is_waiting, false) ) {
+      pthread_cond_signal(&self->ready);
+    }
+
+    pthread_mutex_unlock(&self->lock);
+  }
+
+  return is_okay;
+}
+
+/// after the dispatcher has moved `head`: the store and the exchange are
+/// sequentially consistent, as are the flag and the load of `head` by the
+/// preparing thread, so either it sees the room made in the ring or it is
+/// signaled, and it waits under the lock taken here
+static void ds_pipeline_wake (
+  struct ds_pipeline *          self
+)
+{
+  if ( self->is_split && atomic_exchange(&self->is_waiting, false) ) {
+    pthread_mutex_lock(&self->lock);
+    pthread_cond_signal(&self->ready);
+    pthread_mutex_unlock(&self->lock);
+  }
+}
+
+/// takes the run of prepared events sharing the type and time of the first
+/// one out of the ring, then dispatches it as ds_simulator_simulate() does
+static unsigned int ds_pipeline_dispatch (
+  struct ds_pipeline *          self,
+  struct ds_simulator *         simulator
+)
+{
+  unsigned int      head    = atomic_load_explicit(&self->head, memory_order_relaxed);
+  unsigned int      tail    = atomic_load_explicit(&self->tail, memory_order_acquire);
+  struct ds_event * event   = self->events[ head % DS_PIPELINE_MAX_DEPTH ];
+
+  ds_event_batch_handler handler  = simulator->batch_handlers[ (int)event->type ];
+
+  if ( NULL == handler ) {
+    atomic_store(&self->head, head + 1U);
+    ds_pipeline_wake(self);
+
+    if ( NULL != (void *)simulator->sink ) {
+      ds_sink_write_event(simulator->sink, event);
+    }
+
+    ds_event_process(event);
+    ++simulator->num_type_events[ (int)event->type ];
+
+    ds_event_queue_recycle(&simulator->queue, event);
+    return 1U;
+  }
+
+  struct ds_event * events [ DS_EVENT_BATCH_SIZE ];
+  void *            data [ DS_EVENT_BATCH_SIZE ];
+  unsigned int      num_batched = 0U;
+
+  do {
+    event = self->events[ head % DS_PIPELINE_MAX_DEPTH ];
+
+    if ( 0U < num_batched
+      && ( event->type != events[ 0 ]->type || event->time != events[ 0 ]->time ) )
+      break;
+
+    events[ num_batched ] = event;
+    data[ num_batched ]   = event->data;
+    ++num_batched;
+    ++head;
+
+    if ( NULL != (void *)simulator->sink ) {
+      ds_sink_write_event(simulator->sink, event);
+    }
+  } while ( head != tail && num_batched < DS_EVENT_BATCH_SIZE );
+
+  /// the handler may requeue what is still in the ring, not the batch
+  atomic_store(&self->head, head);
+  ds_pipeline_wake(self);
+
+  handler(simulator, events[ 0 ]->type, events[ 0 ]->time, data, num_batched);
+  simulator->num_type_events[ (int)events[ 0 ]->type ] += num_batched;
+
+  for ( unsigned int index = 0U; index < num_batched; ++index ) {
+    ds_event_queue_recycle(&simulator->queue, events[ index ]);
+  }
+
+  return num_batched;
+}
+
+static void * ds_pipeline_main (
+  void *                        argument
+)
+{
+  struct ds_pipeline * self = (struct ds_pipeline *)argument;
+
+  prctl(PR_SET_NAME, "ash-pipeline", 0, 0, 0);
+
+  pthread_mutex_lock(&self->lock);
+
+  while ( !self->is_stopping ) {
+    /// published before looking at the ring, see ds_pipeline_wake()
+    atomic_store(&self->is_waiting, true);
+
+    if ( self->is_active ) {
+      ds_pipeline_prepare(self);
+    }
+
+    /// the ring is full or the step has nothing more due: waiting hands the
+    /// lock to the handlers until a dispatch, a schedule or a new step
+    pthread_cond_wait(&self->ready, &self->lock);
+  }
+
+  pthread_mutex_unlock(&self->lock);
+
+  return NULL;
+}
+
+bool ds_pipeline_initialize (
+  struct ds_pipeline *          self,
+  unsigned int                  depth,
+  bool                          is_split
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == depth || DS_PIPELINE_MAX_DEPTH < depth ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "depth",
+      "Out of range [1;DS_PIPELINE_MAX_DEPTH]"
+    );
+    return false;
+  }
+
+  atomic_init(&self->head, 0U);
+  atomic_init(&self->tail, 0U);
+  atomic_init(&self->is_waiting, false);
+  self->depth         = depth;
+  self->time_limit    = 0U;
+  self->queue         = (struct ds_event_queue *)NULL;
+  self->num_requeues  = 0ULL;
+  self->is_active     = false;
+  self->is_stopping   = false;
+  self->is_split      = is_split;
+
+  if ( !is_split )
+    return true;
+
+  pthread_mutex_init(&self->lock, NULL);
+  pthread_cond_init(&self->ready, NULL);
+
+  int error = pthread_create(&self->thread, NULL, ds_pipeline_main, self);
+
+  if ( 0 != error ) {
+    ERROR("Cannot create the pipeline thread: %s.", strerror(error));
+    pthread_cond_destroy(&self->ready);
+    pthread_mutex_destroy(&self->lock);
+    return false;
+  }
+
+  return true;
+}
+
+void ds_pipeline_deinitialize (
+  struct ds_pipeline *          self
+)
+{
+  assert(NULL != (void *)self);
+  assert(!self->is_active);
+
+  if ( !self->is_split )
+    return;
+
+  pthread_mutex_lock(&self->lock);
+  self->is_stopping = true;
+  pthread_cond_signal(&self->ready);
+  pthread_mutex_unlock(&self->lock);
+
+  pthread_join(self->thread, NULL);
+
+  pthread_cond_destroy(&self->ready);
+  pthread_mutex_destroy(&self->lock);
+}
+
+unsigned int ds_simulator_simulate_pipelined (
+  struct ds_simulator *         self,
+  struct ds_pipeline *          pipeline
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)pipeline);
+  assert(NULL == (void *)self->pipeline);
+  assert(NULL == (void *)self->timeline);
+
+  unsigned int num_events = 0U;
+  unsigned int time_limit = self->time + self->time_step;
+
+  self->is_stalled  = NULL != (void *)self->spill
+    && !ds_spill_refill(self->spill, &self->queue, time_limit);
+
+  if ( self->is_stalled )
+    return num_events;
+
+  if ( pipeline->is_split ) {
+    pthread_mutex_lock(&pipeline->lock);
+  }
+
+  pipeline->queue       = &self->queue;
+  pipeline->time_limit  = time_limit;
+  pipeline->is_active   = true;
+  self->pipeline        = pipeline;
+
+  if ( pipeline->is_split ) {
+    pthread_cond_signal(&pipeline->ready);
+    pthread_mutex_unlock(&pipeline->lock);
+  }
+
+  do {
+    unsigned int head = atomic_load_explicit(&pipeline->head, memory_order_relaxed);
+
+    if ( !pipeline->is_split ) {
+      /// refill before dispatching, to overlap the misses with the handler
+      ds_pipeline_prepare(pipeline);
+    } else if ( head == atomic_load_explicit(&pipeline->tail, memory_order_acquire) ) {
+      /// the preparing thread is behind: help it, or end the step
+      pthread_mutex_lock(&pipeline->lock);
+
+      if ( 0U == ds_pipeline_prepare(pipeline)
+        && head == atomic_load_explicit(&pipeline->tail, memory_order_relaxed) ) {
+        pipeline->is_active = false;
+      }
+
+      pthread_mutex_unlock(&pipeline->lock);
+    }
+
+    if ( head == atomic_load_explicit(&pipeline->tail, memory_order_acquire) )
+      break;
+
+    num_events += ds_pipeline_dispatch(pipeline, self);
+  } while ( true );
+
+  /// split, the step has been ended under the lock
+  if ( !pipeline->is_split ) {
+    pipeline->is_active = false;
+  }
+
+  self->pipeline  = (struct ds_pipeline *)NULL;
+  self->time     += self->time_step;
+
+  if ( NULL != (void *)self->telemetry ) {
+    ds_telemetry_publish(self->telemetry, self);
+  }
+
+  return num_events;
+}
+
+/// Simulator
+
+static bool ds_simulator_link (
+  struct ds_simulator *         self,
+  struct ds_event *             event
+)
+{
+  /// the event may be dequeued as soon as it is linked
+  unsigned int offset = event->time - self->time;
+
+  if ( NULL != (void *)self->pipeline )
+    return ds_pipeline_insert(self->pipeline, event, offset);
+
+  bool is_okay  = ds_event_queue_insert(&self->queue, event);
+
+  if ( is_okay ) {
+    ds_event_queue_sample(&self->queue, offset);
+  }
+
+  return is_okay;
+}
+
+/// same dispatch as ds_simulator_simulate(), deleting the earliest events
+/// from the timeline: the events of a timestamp are all enqueued by now, the
+/// other threads only enqueuing past the step
+static unsigned int ds_simulator_dispatch_timeline (
+  struct ds_simulator *         self,
+  unsigned int                  time_limit
+)
+{
+  unsigned int    num_events  = 0U;
+  struct ds_event event;
+  struct ds_event next;
+
+  while ( NULL != (void *)ds_event_skiplist_dequeue(self->timeline, time_limit, &event) ) {
+    ds_event_batch_handler handler  = self->batch_handlers[ (int)event.type ];
+
+    if ( NULL != (void *)self->sink ) {
+      ds_sink_write_event(self->sink, &event);
+    }
+
+    if ( NULL == handler ) {
+      ds_event_process(&event);
+      ++num_events;
+      ++self->num_type_events[ (int)event.type ];
+      continue;
+    }
+
+    /// gather the run of events sharing this type and time
+    void *        data [ DS_EVENT_BATCH_SIZE ];
+    unsigned int  num_batched = 0U;
+
+    do {
+      data[ num_batched ] = event.data;
+      ++num_batched;
+
+      if ( DS_EVENT_BATCH_SIZE == num_batched )
+        break;
+
+      if ( NULL == (void *)ds_event_skiplist_peek(self->timeline, event.time + 1U, &next)
+        || next.type != event.type )
+        break;
+
+      ds_event_skiplist_dequeue(self->timeline, time_limit, &event);
+
+      if ( NULL != (void *)self->sink ) {
+        ds_sink_write_event(self->sink, &event);
+      }
+    } while ( true );
+
+    handler(self, event.type, event.time, data, num_batched);
+    num_events += num_batched;
+    self->num_type_events[ (int)event.type ] += num_batched;
+  }
+
+  return num_events;
+}
+
+bool ds_simulator_initialize (
+  struct ds_simulator *         self,
+  unsigned int                  max_events,
+  unsigned int                  max_bins,
+  unsigned int                  time_step,
+  enum ds_memory_flags          flags
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == time_step ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "time_step",
+      "Out of range [1;MAX_UINT]"
+    );
+    return false;
+  }
+
+  bool is_okay;
+
+  is_okay = ds_event_queue_initialize(&self->queue, max_events, max_bins, flags);
+
+  if ( !is_okay )
+    return is_okay;
+
+  self->time      = 0U;
+  self->time_step = time_step;
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    self->batch_handlers[ type ]  = (ds_event_batch_handler)NULL;
+  }
+
+  self->sink      = (struct ds_sink *)NULL;
+  self->spill     = (struct ds_spill *)NULL;
+  self->telemetry = (struct ds_telemetry *)NULL;
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    self->num_type_events[ type ] = 0ULL;
+  }
+
+  self->seed        = 0U;
+  self->pipeline    = (struct ds_pipeline *)NULL;
+  self->timeline    = (struct ds_event_skiplist_thread *)NULL;
+  self->is_stalled  = false;
+
+  return true;
+}
+
+void ds_simulator_deinitialize (
+  struct ds_simulator *         self
+)
+{
+  assert(NULL != (void *)self);
+  assert(0U != self->time_step);
+
+  ds_event_queue_deinitialize(&self->queue);
+}
+
+bool ds_simulator_schedule (
+  struct ds_simulator *         self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( time < self->time ) {
+    ERROR("Invalid argument `%s`: Scheduling time %u has to be >=%u.",
+      "time",
+      time,
+      self->time
+    );
+    return false;
+  }
+
+  if ( NULL != (void *)self->timeline )
+    return ds_event_skiplist_enqueue(self->timeline, time, type, data);
+
+  if ( NULL != (void *)self->spill && time >= self->spill->horizon )
+    return ds_spill_append(self->spill, time, type, data);
+
+  struct ds_event * event = ds_event_pool_acquire(&self->queue.events,
+    time,
+    type,
+    data
+  );
+
+  if ( NULL == (void *)event )
+    return false;
+
+  bool is_okay  = ds_simulator_link(self, event);
+
+  if ( !is_okay ) {
+    ds_event_pool_release(&self->queue.events, event);
+  }
+
+  return is_okay;
+}
+
+bool ds_simulator_insert (
+  struct ds_simulator *         self,
+  struct ds_event *             event
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)event);
+  assert(NULL == (void *)event->next);
+
+  if ( event->time < self->time ) {
+    ERROR("Invalid argument `%s`: Scheduling time %u has to be >=%u.",
+      "event",
+      event->time,
+      self->time
+    );
+    return false;
+  }
+
+  if ( NULL != (void *)self->timeline ) {
+    if ( !ds_event_skiplist_enqueue(self->timeline, event->time, event->type, event->data) )
+      return false;
+
+    ds_event_pool_release(&self->queue.events, event);
+    return true;
+  }
+
+  if ( NULL != (void *)self->spill && event->time >= self->spill->horizon ) {
+    if ( !ds_spill_append(self->spill, event->time, event->type, event->data) )
+      return false;
+
+    ds_event_pool_release(&self->queue.events, event);
+    return true;
+  }
+
+  return ds_simulator_link(self, event);
+}
+
+unsigned int ds_simulator_simulate (
+  struct ds_simulator *         self
+)
+{
+  assert(NULL != (void *)self);
+
+  unsigned int num_events = 0U;
+  unsigned int time_limit = self->time + self->time_step;
+
+  self->is_stalled  = NULL != (void *)self->spill
+    && !ds_spill_refill(self->spill, &self->queue, time_limit);
+
+  if ( self->is_stalled )
+    return num_events;
+
+  /// with a timeline, the queue stays empty
+  if ( NULL != (void *)self->timeline ) {
+    num_events  = ds_simulator_dispatch_timeline(self, time_limit);
+  }
+
+  do {
+    struct ds_event * event = ds_event_queue_dequeue(&self->queue, time_limit);
+
+    if ( NULL == (void *)event )
+      break;
+
+    /// overlap the misses of the next dispatch with this one
+    ds_event_queue_prefetch(&self->queue);
+
+    ds_event_batch_handler handler  = self->batch_handlers[ (int)event->type ];
+
+    if ( NULL != (void *)self->sink ) {
+      ds_sink_write_event(self->sink, event);
+    }
+
+    if ( NULL == handler ) {
+      ds_event_process(event);
+      ++num_events;
+      ++self->num_type_events[ (int)event->type ];
+
+      ds_event_queue_recycle(&self->queue, event);
+      continue;
+    }
+
+    /// gather the run of events sharing this type and time
+    struct ds_event * events [ DS_EVENT_BATCH_SIZE ];
+    void *            data [ DS_EVENT_BATCH_SIZE ];
+    unsigned int      num_batched = 0U;
+
+    do {
+      events[ num_batched ] = event;
+      data[ num_batched ]   = event->data;
+      ++num_batched;
+
+      if ( DS_EVENT_BATCH_SIZE == num_batched )
+        break;
+
+      struct ds_event * next  = ds_event_queue_peek(&self->queue, time_limit);
+
+      if ( NULL == (void *)next
+        || next->type != events[ 0 ]->type
+        || next->time != events[ 0 ]->time )
+        break;
+
+      event = ds_event_queue_dequeue(&self->queue, time_limit);
+
+      if ( NULL != (void *)self->sink ) {
+        ds_sink_write_event(self->sink, event);
+      }
+    } while ( true );
+
+    handler(self, events[ 0 ]->type, events[ 0 ]->time, data, num_batched);
+    num_events += num_batched;
+    self->num_type_events[ (int)events[ 0 ]->type ] += num_batched;
+
+    for ( unsigned int index = 0U; index < num_batched; ++index ) {
+      ds_event_queue_recycle(&self->queue, events[ index ]);
+    }
+  } while ( true );
+
+  self->time += self->time_step;
+
+  if ( NULL != (void *)self->telemetry ) {
+    ds_telemetry_publish(self->telemetry, self);
+  }
+
+  return num_events;
+}
+
+/// events of the queue, and those in the ring of a pipelined step
+static unsigned int ds_simulator_count_events (
+  struct ds_simulator *         self
+)
+{
+  struct ds_pipeline * pipeline = self->pipeline;
+
+  if ( NULL == (void *)pipeline )
+    return self->queue.num_events;
+
+  if ( pipeline->is_split ) {
+    pthread_mutex_lock(&pipeline->lock);
+  }
+
+  unsigned int num_events = self->queue.num_events
+    + atomic_load_explicit(&pipeline->tail, memory_order_relaxed)
+    - atomic_load_explicit(&pipeline->head, memory_order_relaxed);
+
+  if ( pipeline->is_split ) {
+    pthread_mutex_unlock(&pipeline->lock);
+  }
+
+  return num_events;
+}
+
+bool ds_simulator_is_empty (
+  struct ds_simulator *         self
+)
+{
+  assert(NULL != (void *)self);
+
+  return 0U == ds_simulator_count_events(self)
+    && ( NULL == (void *)self->spill || ds_spill_is_empty(self->spill) )
+    && ( NULL == (void *)self->timeline || ds_event_skiplist_is_empty(self->timeline) );
+}
+
+unsigned int ds_simulator_drain (
+  struct ds_simulator *         self
+)
+{
+  assert(NULL != (void *)self);
+
+  unsigned int num_events = 0U;
+
+  do {
+    struct ds_event * event = ds_event_queue_dequeue(&self->queue, UINT_MAX);
+
+    if ( NULL == (void *)event )
+      break;
+
+    ++num_events;
+
+    ds_event_queue_recycle(&self->queue, event);
+  } while ( true );
+
+  if ( NULL != (void *)self->spill ) {
+    num_events += (unsigned int)ds_spill_clear(self->spill);
+  }
+
+  if ( NULL != (void *)self->timeline ) {
+    struct ds_event event;
+
+    while ( NULL != (void *)ds_event_skiplist_dequeue(self->timeline, UINT_MAX, &event) ) {
+      ++num_events;
+    }
+  }
+
+  return num_events;
+}
+
+bool ds_simulator_set_batch_handler (
+  struct ds_simulator *         self,
+  enum ds_event_type            type,
+  ds_event_batch_handler        handler
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( (int)DS_NUM_EVENT_TYPES <= (int)type ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "type",
+      "Out of range [0;DS_NUM_EVENT_TYPES-1]"
+    );
+    return false;
+  }
+
+  self->batch_handlers[ (int)type ] = handler;
+  return true;
+}
+
+void ds_simulator_reset (
+  struct ds_simulator *         self
+)
+{
+  assert(NULL != (void *)self);
+
+  /// recycle the pending events, keeping the pools allocated
+  ds_simulator_drain(self);
+  ds_event_queue_reset(&self->queue);
+
+  self->time  = 0U;
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    self->num_type_events[ type ] = 0ULL;
+  }
+
+  if ( NULL != (void *)self->spill ) {
+    self->spill->horizon  = self->spill->window;
+  }
+}
+
+void ds_simulator_set_sink (
+  struct ds_simulator *         self,
+  struct ds_sink *              sink
+)
+{
+  assert(NULL != (void *)self);
+
+  self->sink  = sink;
+}
+
+void ds_simulator_set_seed (
+  struct ds_simulator *         self,
+  uint64_t                      seed
+)
+{
+  assert(NULL != (void *)self);
+
+  self->seed  = seed;
+}
+
+void ds_simulator_open_random (
+  struct ds_simulator *         self,
+  struct ds_random *            random,
+  uint64_t                      stream
+)
+{
+  assert(NULL != (void *)self);
+
+  ds_random_initialize(random, self->seed, stream);
+}
+
+void ds_simulator_set_telemetry (
+  struct ds_simulator *         self,
+  struct ds_telemetry *         telemetry
+)
+{
+  assert(NULL != (void *)self);
+
+  self->telemetry = telemetry;
+}
+
+
+void ds_simulator_set_spill (
+  struct ds_simulator *         self,
+  struct ds_spill *             spill
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL == (void *)spill || ds_spill_is_empty(spill));
+  assert(NULL == (void *)spill || NULL == (void *)self->timeline);
+
+  self->spill = spill;
+
+  if ( NULL != (void *)spill ) {
+    unsigned long long horizon = (unsigned long long)self->time + spill->window;
+
+    spill->horizon  = horizon < UINT_MAX ? (unsigned int)horizon : UINT_MAX;
+  }
+}
+
+bool ds_simulator_set_timeline (
+  struct ds_simulator *         self,
+  struct ds_event_skiplist_thread * timeline
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( NULL != (void *)timeline
+    && ( !ds_event_queue_is_empty(&self->queue) || NULL != (void *)self->spill ) ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "timeline",
+      "The queue has to be empty, without a spill"
+    );
+    return false;
+  }
+
+  self->timeline  = timeline;
+  return true;
+}
+
+/// Process
+
+/// a fresh stack returns into the trampoline, which calls ds_process_main()
+/// with the process left in a callee-saved register
+void ds_process_trampoline ( void );
+
+void ds_process_main (
+  struct ds_process *           self
+) __attribute__(( used, noreturn ));
+
+# if defined(__x86_64__)
+
+#   define DS_PROCESS_NUM_SLOTS         7U
+#   define DS_PROCESS_SLOT_PROCESS      4U
+#   define DS_PROCESS_SLOT_RETURN       6U
+
+__asm__ (
+  "  .text\n"
+  "  .p2align 4\n"
+  "  .globl ds_process_context_switch\n"
+  "  .hidden ds_process_context_switch\n"
+  "  .type ds_process_context_switch, @function\n"
+  "ds_process_context_switch:\n"
+  "  pushq %rbp\n"
+  "  pushq %rbx\n"
+  "  pushq %r12\n"
+  "  pushq %r13\n"
+  "  pushq %r14\n"
+  "  pushq %r15\n"
+  "  movq %rsp, (%rdi)\n"
+  "  movq (%rsi), %rsp\n"
+  "  popq %r15\n"
+  "  popq %r14\n"
+  "  popq %r13\n"
+  "  popq %r12\n"
+  "  popq %rbx\n"
+  "  popq %rbp\n"
+  "  ret\n"
+  "  .size ds_process_context_switch, .-ds_process_context_switch\n"
+  "  .p2align 4\n"
+  "  .globl ds_process_trampoline\n"
+  "  .hidden ds_process_trampoline\n"
+  "  .type ds_process_trampoline, @function\n"
+  "ds_process_trampoline:\n"
+  "  movq %rbx, %rdi\n"
+  "  call ds_process_main\n"
+  "  ud2\n"
+  "  .size ds_process_trampoline, .-ds_process_trampoline\n"
+);
+
+# elif defined(__aarch64__)
+
+/// x19-x30, then d8-d15
+#   define DS_PROCESS_NUM_SLOTS         20U
+#   define DS_PROCESS_SLOT_PROCESS      0U
+#   define DS_PROCESS_SLOT_RETURN       11U
+
+__asm__ (
+  "  .text\n"
+  "  .p2align 4\n"
+  "  .globl ds_process_context_switch\n"
+  "  .hidden ds_process_context_switch\n"
+  "  .type ds_process_context_switch, %function\n"
+  "ds_process_context_switch:\n"
+  "  sub sp, sp, #160\n"
+  "  stp x19, x20, [sp, #0]\n"
+  "  stp x21, x22, [sp, #16]\n"
+  "  stp x23, x24, [sp, #32]\n"
+  "  stp x25, x26, [sp, #48]\n"
+  "  stp x27, x28, [sp, #64]\n"
+  "  stp x29, x30, [sp, #80]\n"
+  "  stp d8, d9, [sp, #96]\n"
+  "  stp d10, d11, [sp, #112]\n"
+  "  stp d12, d13, [sp, #128]\n"
+  "  stp d14, d15, [sp, #144]\n"
+  "  mov x2, sp\n"
+  "  str x2, [x0]\n"
+  "  ldr x2, [x1]\n"
+  "  mov sp, x2\n"
+  "  ldp x19, x20, [sp, #0]\n"
+  "  ldp x21, x22, [sp, #16]\n"
+  "  ldp x23, x24, [sp, #32]\n"
+  "  ldp x25, x26, [sp, #48]\n"
+  "  ldp x27, x28, [sp, #64]\n"
+  "  ldp x29, x30, [sp, #80]\n"
+  "  ldp d8, d9, [sp, #96]\n"
+  "  ldp d10, d11, [sp, #112]\n"
+  "  ldp d12, d13, [sp, #128]\n"
+  "  ldp d14, d15, [sp, #144]\n"
+  "  add sp, sp, #160\n"
+  "  ret\n"
+  "  .size ds_process_context_switch, .-ds_process_context_switch\n"
+  "  .p2align 4\n"
+  "  .globl ds_process_trampoline\n"
+  "  .hidden ds_process_trampoline\n"
+  "  .type ds_process_trampoline, %function\n"
+  "ds_process_trampoline:\n"
+  "  mov x0, x19\n"
+  "  bl ds_process_main\n"
+  "  brk #0\n"
+  "  .size ds_process_trampoline, .-ds_process_trampoline\n"
+);
+
+# else
+
+#   define DS_PROCESS_NUM_SLOTS         0U
+
+void ds_process_context_switch (
+  struct ds_process_context *   from,
+  struct ds_process_context *   to
+)
+{
+  (void)from;
+  (void)to;
+
+  abort();
+}
+
+void ds_process_trampoline ( void )
+{
+  abort();
+}
+
+# endif
+
+void ds_process_main (
+  struct ds_process *           self
+)
+{
+  self->body(self, self->argument);
+
+  /// never switched back to: the scheduler recycles the stack
+  self->state = DS_PROCESS_STATE_TERMINATED;
+  ds_process_context_switch(&self->context, &self->arena->scheduler);
+
+  abort();
+}
+
+static void ds_process_prepare (
+  struct ds_process *           self
+)
+{
+# if 0U < DS_PROCESS_NUM_SLOTS
+  /// the frame the first switch pops: 16-byte aligned once popped (x86-64
+  /// then returns into the trampoline, as if called, minus the return address)
+  uintptr_t   top   = ( (uintptr_t)( self->stack + self->arena->stack_size ) & ~(uintptr_t)15U ) - 16U;
+  uintptr_t * slots = (uintptr_t *)( top - DS_PROCESS_NUM_SLOTS * sizeof(uintptr_t) );
+
+  for ( unsigned int slot = 0U; slot < DS_PROCESS_NUM_SLOTS; ++slot ) {
+    slots[ slot ] = 0U;
+  }
+
+  slots[ DS_PROCESS_SLOT_PROCESS ]  = (uintptr_t)self;
+  slots[ DS_PROCESS_SLOT_RETURN ]   = (uintptr_t)ds_process_trampoline;
+
+  self->context.stack_pointer = (void *)slots;
+# else
+  (void)self;
+# endif
+}
+
+bool ds_process_arena_initialize (
+  struct ds_process_arena *     self,
+  unsigned int                  max_processes,
+  size_t                        stack_size
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == DS_PROCESS_NUM_SLOTS ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "self",
+      "Processes are not supported on this architecture"
+    );
+    return false;
+  }
+
+  if ( 0U == max_processes ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "max_processes",
+      "Out of range [1;MAX_UINT]"
+    );
+    return false;
+  }
+
+  if ( 4096U > stack_size || 0U != stack_size % 16U ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "stack_size",
+      "Has to be a multiple of 16, >=4096"
+    );
+    return false;
+  }
+
+  struct ds_process * processes
+    = (struct ds_process *)malloc(
+      (size_t)max_processes * sizeof(*processes)
+    );
+
+  if ( NULL == (void *)processes ) {
+    ERROR("Cannot allocate %u processes: %s.",
+      max_processes,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  void * stacks = mmap(NULL,
+    (size_t)max_processes * stack_size,
+    PROT_READ | PROT_WRITE,
+    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+    -1,
+    0
+  );
+
+  if ( MAP_FAILED == stacks ) {
+    ERROR("Cannot map %u stacks: %s.",
+      max_processes,
+      strerror(errno)
+    );
+    free(processes);
+    return false;
+  }
+
+  self->processes     = processes;
+  self->stacks        = (char *)stacks;
+  self->stack_size    = stack_size;
+  self->max_processes = max_processes;
+  self->num_processes = 0U;
+  self->free_process  = processes;
+  self->current       = (struct ds_process *)NULL;
+
+  /// initialize the free list
+
+  for ( unsigned int index = 0U; index < max_processes; ++index ) {
+    struct ds_process * process = processes + index;
+
+    process->next   = index + 1U < max_processes ? process + 1 : (struct ds_process *)NULL;
+    process->arena  = self;
+    process->stack  = self->stacks + (size_t)index * stack_size;
+    process->state  = DS_PROCESS_STATE_FREE;
+  }
+
+  return true;
+}
+
+void ds_process_arena_deinitialize (
+  struct ds_process_arena *     self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->processes);
+  assert(NULL == (void *)self->current);
+
+  munmap(self->stacks, (size_t)self->max_processes * self->stack_size);
+  free(self->processes);
+}
+
+struct ds_process * ds_process_spawn (
+  struct ds_process_arena *     arena,
+  struct ds_simulator *         simulator,
+  unsigned int                  time,
+  ds_process_body               body,
+  void *                        argument
+)
+{
+  assert(NULL != (void *)arena);
+  assert(NULL != (void *)simulator);
+
+  if ( NULL == body ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "body",
+      "Unexpected null pointer"
+    );
+    return (struct ds_process *)NULL;
+  }
+
+  struct ds_process * process = arena->free_process;
+
+  if ( NULL == (void *)process ) {
+    ERROR("Out of memory: Maximum number of processes (%u) has been reached.",
+      arena->max_processes
+    );
+    return process;
+  }
+
+  process->simulator  = simulator;
+  process->body       = body;
+  process->argument   = argument;
+  process->time       = time;
+
+  if ( !ds_simulator_schedule(simulator, time, DS_EVENT_TYPE_PROCESS, process) )
+    return (struct ds_process *)NULL;
+
+  ds_process_prepare(process);
+
+  arena->free_process = process->next;
+  process->next       = (struct ds_process *)NULL;
+  process->state      = DS_PROCESS_STATE_SCHEDULED;
+  ++arena->num_processes;
+
+  return process;
+}
+
+void ds_process_resume (
+  struct ds_process *           self,
+  unsigned int                  time
+)
+{
+  assert(NULL != (void *)self);
+  assert(DS_PROCESS_STATE_SCHEDULED == self->state);
+
+  struct ds_process_arena * arena = self->arena;
+
+  assert(NULL == (void *)arena->current);
+
+  self->time      = time;
+  self->state     = DS_PROCESS_STATE_RUNNING;
+  arena->current  = self;
+
+  ds_process_context_switch(&arena->scheduler, &self->context);
+
+  arena->current  = (struct ds_process *)NULL;
+
+  if ( DS_PROCESS_STATE_TERMINATED == self->state ) {
+    self->state         = DS_PROCESS_STATE_FREE;
+    self->next          = arena->free_process;
+    arena->free_process = self;
+    --arena->num_processes;
+  }
+}
+
+bool ds_process_hold (
+  struct ds_process *           self,
+  unsigned int                  delay
+)
+{
+  assert(NULL != (void *)self);
+  assert(self == self->arena->current);
+
+  if ( UINT_MAX - self->time < delay ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "delay",
+      "Out of range [0;MAX_UINT-time]"
+    );
+    return false;
+  }
+
+  if ( !ds_simulator_schedule(self->simulator, self->time + delay, DS_EVENT_TYPE_PROCESS, self) )
+    return false;
+
+  self->state = DS_PROCESS_STATE_SCHEDULED;
+  ds_process_context_switch(&self->context, &self->arena->scheduler);
+
+  return true;
+}
+
+void ds_process_passivate (
+  struct ds_process *           self
+)
+{
+  assert(NULL != (void *)self);
+  assert(self == self->arena->current);
+
+  self->state = DS_PROCESS_STATE_PASSIVE;
+  ds_process_context_switch(&self->context, &self->arena->scheduler);
+}
+
+bool ds_process_activate (
+  struct ds_process *           self,
+  unsigned int                  time
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( DS_PROCESS_STATE_PASSIVE != self->state ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "self",
+      "Not passive"
+    );
+    return false;
+  }
+
+  if ( !ds_simulator_schedule(self->simulator, time, DS_EVENT_TYPE_PROCESS, self) )
+    return false;
+
+  self->state = DS_PROCESS_STATE_SCHEDULED;
+  return true;
+}
+
+/// Resource
+
+static struct ds_event * ds_resource_acquire (
+  struct ds_simulator *         simulator,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  return ds_event_pool_acquire(&simulator->queue.events, time, type, data);
+}
+
+/// links a waiting event into the bin of `time`; the event is recycled if
+/// it cannot be
+static bool ds_resource_wake (
+  struct ds_simulator *         simulator,
+  struct ds_event *             event,
+  unsigned int                  time
+)
+{
+  event->time = time;
+
+  if ( ds_simulator_insert(simulator, event) )
+    return true;
+
+  ds_event_pool_release(&simulator->queue.events, event);
+  return false;
+}
+
+static void ds_resource_drop (
+  struct ds_simulator *         simulator,
+  struct ds_event_list *        list
+)
+{
+  struct ds_event * event;
+
+  while ( NULL != (void *)( event = ds_event_list_remove(list) ) ) {
+    ds_event_pool_release(&simulator->queue.events, event);
+  }
+
+  ds_event_list_deinitialize(list);
+}
+
+bool ds_resource_initialize (
+  struct ds_resource *          self,
+  struct ds_simulator *         simulator,
+  unsigned int                  capacity
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( NULL == (void *)simulator ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "simulator",
+      "Unexpected null pointer"
+    );
+    return false;
+  }
+
+  if ( 0U == capacity ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "capacity",
+      "Out of range [1;UINT_MAX]"
+    );
+    return false;
+  }
+
+  ds_event_list_initialize(&self->waiters);
+
+  self->simulator     = simulator;
+  self->capacity      = capacity;
+  self->num_busy      = 0U;
+  self->num_waiters   = 0U;
+  self->num_requests  = 0ULL;
+  self->num_waits     = 0ULL;
+  self->wait_time     = 0ULL;
+
+  return true;
+}
+
+void ds_resource_deinitialize (
+  struct ds_resource *          self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  ds_resource_drop(self->simulator, &self->waiters);
+
+  self->num_waiters = 0U;
+}
+
+bool ds_resource_request (
+  struct ds_resource *          self,
+  unsigned int                  time,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  struct ds_event * event = ds_resource_acquire(self->simulator, time, type, data);
+
+  if ( NULL == (void *)event )
+    return false;
+
+  ++self->num_requests;
+
+  /// requests only wait while every unit is busy
+  if ( self->num_busy < self->capacity ) {
+    if ( !ds_resource_wake(self->simulator, event, time) )
+      return false;
+
+    ++self->num_busy;
+    return true;
+  }
+
+  /// the event keeps the time of the request until granted
+  ds_event_list_insert(&self->waiters, event);
+  ++self->num_waiters;
+  ++self->num_waits;
+
+  return true;
+}
+
+bool ds_resource_release (
+  struct ds_resource *          self,
+  unsigned int                  time
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  if ( 0U == self->num_busy ) {
+    ERROR("Invalid state: %s.",
+      "No unit of the resource is held"
+    );
+    return false;
+  }
+
+  struct ds_event * event = ds_event_list_remove(&self->waiters);
+
+  if ( NULL == (void *)event ) {
+    --self->num_busy;
+    return true;
+  }
+
+  --self->num_waiters;
+  self->wait_time  += time - event->time;
+
+  /// the unit goes straight to the waiter, and stays busy
+  if ( !ds_resource_wake(self->simulator, event, time) ) {
+    --self->num_busy;
+    return false;
+  }
+
+  return true;
+}
+
+bool ds_store_initialize (
+  struct ds_store *             self,
+  struct ds_simulator *         simulator,
+  unsigned int                  capacity
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( NULL == (void *)simulator ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "simulator",
+      "Unexpected null pointer"
+    );
+    return false;
+  }
+
+  if ( 0U == capacity ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "capacity",
+      "Out of range [1;UINT_MAX]"
+    );
+    return false;
+  }
+
+  ds_event_list_initialize(&self->items);
+  ds_event_list_initialize(&self->getters);
+  ds_event_list_initialize(&self->putters);
+  ds_event_list_initialize(&self->pending_items);
+
+  self->simulator = simulator;
+  self->capacity  = capacity;
+  self->num_items = 0U;
+
+  return true;
+}
+
+void ds_store_deinitialize (
+  struct ds_store *             self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  ds_resource_drop(self->simulator, &self->items);
+  ds_resource_drop(self->simulator, &self->getters);
+  ds_resource_drop(self->simulator, &self->putters);
+  ds_resource_drop(self->simulator, &self->pending_items);
+
+  self->num_items = 0U;
+}
+
+bool ds_store_put (
+  struct ds_store *             self,
+  unsigned int                  time,
+  void *                        item,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  struct ds_event * event = ds_resource_acquire(self->simulator, time, type, data);
+
+  if ( NULL == (void *)event )
+    return false;
+
+  /// gets only wait while the store is empty
+  struct ds_event * getter  = ds_event_list_remove(&self->getters);
+
+  if ( NULL != (void *)getter ) {
+    getter->data  = item;
+
+    if ( !ds_resource_wake(self->simulator, getter, time) ) {
+      ds_event_pool_release(&self->simulator->queue.events, event);
+      return false;
+    }
+
+    return ds_resource_wake(self->simulator, event, time);
+  }
+
+  struct ds_event * node  = ds_resource_acquire(self->simulator, time, type, item);
+
+  if ( NULL == (void *)node ) {
+    ds_event_pool_release(&self->simulator->queue.events, event);
+    return false;
+  }
+
+  if ( self->num_items < self->capacity ) {
+    ds_event_list_insert(&self->items, node);
+    ++self->num_items;
+
+    return ds_resource_wake(self->simulator, event, time);
+  }
+
+  /// full: the item waits along with its put
+  ds_event_list_insert(&self->putters, event);
+  ds_event_list_insert(&self->pending_items, node);
+
+  return true;
+}
+
+bool ds_store_get (
+  struct ds_store *             self,
+  unsigned int                  time,
+  enum ds_event_type            type
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  if ( (int)DS_NUM_EVENT_TYPES <= (int)type ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "type",
+      "Out of range [0;DS_NUM_EVENT_TYPES-1]"
+    );
+    return false;
+  }
+
+  struct ds_event * node  = ds_event_list_remove(&self->items);
+
+  if ( NULL == (void *)node ) {
+    struct ds_event * getter  = ds_resource_acquire(self->simulator, time, type, NULL);
+
+    if ( NULL == (void *)getter )
+      return false;
+
+    ds_event_list_insert(&self->getters, getter);
+    return true;
+  }
+
+  /// the event of the item carries it to the get
+  --self->num_items;
+  node->type  = type;
+
+  bool is_okay  = ds_resource_wake(self->simulator, node, time);
+
+  /// room for the earliest blocked put
+  struct ds_event * putter  = ds_event_list_remove(&self->putters);
+
+  if ( NULL != (void *)putter ) {
+    ds_event_list_insert(&self->items, ds_event_list_remove(&self->pending_items));
+    ++self->num_items;
+
+    is_okay = ds_resource_wake(self->simulator, putter, time) && is_okay;
+  }
+
+  return is_okay;
+}
+
+bool ds_container_initialize (
+  struct ds_container *         self,
+  struct ds_simulator *         simulator,
+  unsigned int                  capacity,
+  unsigned int                  level
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( NULL == (void *)simulator ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "simulator",
+      "Unexpected null pointer"
+    );
+    return false;
+  }
+
+  if ( 0U == capacity ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "capacity",
+      "Out of range [1;UINT_MAX]"
+    );
+    return false;
+  }
+
+  if ( capacity < level ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "level",
+      "Out of range [0;capacity]"
+    );
+    return false;
+  }
+
+  ds_event_list_initialize(&self->getters);
+  ds_event_list_initialize(&self->get_amounts);
+  ds_event_list_initialize(&self->putters);
+  ds_event_list_initialize(&self->put_amounts);
+
+  self->simulator = simulator;
+  self->capacity  = capacity;
+  self->level     = level;
+
+  return true;
+}
+
+void ds_container_deinitialize (
+  struct ds_container *         self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  ds_resource_drop(self->simulator, &self->getters);
+  ds_resource_drop(self->simulator, &self->get_amounts);
+  ds_resource_drop(self->simulator, &self->putters);
+  ds_resource_drop(self->simulator, &self->put_amounts);
+}
+
+/// serves the blocked operations of `waiters` in order, while they fit
+static bool ds_container_serve (
+  struct ds_container *         self,
+  unsigned int                  time,
+  struct ds_event_list *        waiters,
+  struct ds_event_list *        amounts,
+  bool                          is_put
+)
+{
+  bool is_okay  = true;
+
+  while ( !ds_event_list_is_empty(waiters) ) {
+    unsigned int amount = (unsigned int)(uintptr_t)amounts->head->data;
+
+    if ( is_put ? self->capacity - self->level < amount : self->level < amount )
+      break;
+
+    if ( is_put ) {
+      self->level  += amount;
+    } else {
+      self->level  -= amount;
+    }
+
+    ds_event_pool_release(&self->simulator->queue.events, ds_event_list_remove(amounts));
+    is_okay = ds_resource_wake(self->simulator, ds_event_list_remove(waiters), time) && is_okay;
+  }
+
+  return is_okay;
+}
+
+/// adds (or removes) `amount` at once if nothing of the same kind waits and
+/// it fits, then serves the operations of the other kind it unblocks
+static bool ds_container_transfer (
+  struct ds_container *         self,
+  unsigned int                  time,
+  unsigned int                  amount,
+  enum ds_event_type            type,
+  void *                        data,
+  bool                          is_put
+)
+{
+  if ( self->capacity < amount ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "amount",
+      "Out of range [0;capacity]"
+    );
+    return false;
+  }
+
+  struct ds_event_list *  waiters = is_put ? &self->putters : &self->getters;
+  struct ds_event_list *  amounts = is_put ? &self->put_amounts : &self->get_amounts;
+  struct ds_event *       event   = ds_resource_acquire(self->simulator, time, type, data);
+
+  if ( NULL == (void *)event )
+    return false;
+
+  bool is_fitting = is_put ? amount <= self->capacity - self->level : amount <= self->level;
+
+  if ( ds_event_list_is_empty(waiters) && is_fitting ) {
+    if ( is_put ) {
+      self->level  += amount;
+    } else {
+      self->level  -= amount;
+    }
+
+    bool is_okay  = ds_resource_wake(self->simulator, event, time);
+
+    return ds_container_serve(self,
+      time,
+      is_put ? &self->getters : &self->putters,
+      is_put ? &self->get_amounts : &self->put_amounts,
+      !is_put
+    ) && is_okay;
+  }
+
+  struct ds_event * node  = ds_resource_acquire(self->simulator,
+    time,
+    type,
+    (void *)(uintptr_t)amount
+  );
+
+  if ( NULL == (void *)node ) {
+    ds_event_pool_release(&self->simulator->queue.events, event);
+    return false;
+  }
+
+  ds_event_list_insert(waiters, event);
+  ds_event_list_insert(amounts, node);
+
+  return true;
+}
+
+bool ds_container_put (
+  struct ds_container *         self,
+  unsigned int                  time,
+  unsigned int                  amount,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  return ds_container_transfer(self, time, amount, type, data, true);
+}
+
+bool ds_container_get (
+  struct ds_container *         self,
+  unsigned int                  time,
+  unsigned int                  amount,
+  enum ds_event_type            type,
+  void *                        data
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->simulator);
+
+  return ds_container_transfer(self, time, amount, type, data, false);
+}
+
+/// Ensemble
+
+static unsigned long long ds_ensemble_pack (
+  unsigned int                  begin,
+  unsigned int                  end
+)
+{
+  return ( (unsigned long long)begin << 32U ) | (unsigned long long)end;
+}
+
+static bool ds_ensemble_worker_pop (
+  struct ds_ensemble_worker *   self,
+  unsigned int *                replication
+)
+{
+  unsigned long long range  = atomic_load(&self->range);
+
+  do {
+    unsigned int begin  = (unsigned int)( range >> 32U );
+    unsigned int end    = (unsigned int)range;
+
+    if ( begin >= end )
+      return false;
+
+    if ( atomic_compare_exchange_weak(&self->range, &range, ds_ensemble_pack(begin + 1U, end)) ) {
+      *replication  = begin;
+      return true;
+    }
+  } while ( true );
+}
+
+static bool ds_ensemble_worker_steal (
+  struct ds_ensemble_worker *   self
+)
+{
+  struct ds_ensemble * ensemble = self->ensemble;
+
+  for ( unsigned int step = 1U; step < ensemble->num_workers; ++step ) {
+    struct ds_ensemble_worker * victim  = ensemble->workers
+      + ( self->index + step ) % ensemble->num_workers;
+    unsigned long long          range   = atomic_load(&victim->range);
+
+    do {
+      unsigned int begin  = (unsigned int)( range >> 32U );
+      unsigned int end    = (unsigned int)range;
+
+      if ( begin >= end )
+        break;
+
+      /// take the upper half, leaving the victim its next replications
+      unsigned int middle = end - ( end - begin + 1U ) / 2U;
+
+      if ( atomic_compare_exchange_weak(&victim->range, &range, ds_ensemble_pack(begin, middle)) ) {
+        atomic_store(&self->range, ds_ensemble_pack(middle, end));
+        return true;
+      }
+    } while ( true );
+  }
+
+  return false;
+}
+
+static void ds_ensemble_worker_run (
+  struct ds_ensemble_worker *   self
+)
+{
+  struct ds_ensemble * ensemble = self->ensemble;
+
+  memset(self->accumulator, 0, ensemble->result_size);
+  self->num_replications  = 0U;
+  self->is_okay           = true;
+
+  do {
+    unsigned int replication;
+
+    while ( ds_ensemble_worker_pop(self, &replication) ) {
+      ds_simulator_reset(&self->simulator);
+      ds_simulator_set_seed(&self->simulator, replication);
+      memset(self->result, 0, ensemble->result_size);
+
+      bool is_okay  = ensemble->replicate(&self->simulator,
+        replication,
+        self->result,
+        ensemble->context
+      );
+
+      if ( !is_okay ) {
+        ERROR("Replication %u has failed.", replication);
+        self->is_okay = false;
+        continue;
+      }
+
+      ensemble->reduce(self->accumulator, self->result, ensemble->context);
+      ++self->num_replications;
+    }
+  } while ( ds_ensemble_worker_steal(self) );
+}
+
+static void * ds_ensemble_worker_main (
+  void *                        argument
+)
+{
+  struct ds_ensemble_worker * self      = (struct ds_ensemble_worker *)argument;
+  struct ds_ensemble *        ensemble  = self->ensemble;
+
+  /// allocate on the worker thread, so that the pools are first touched here
+  self->is_okay = ds_simulator_initialize(&self->simulator,
+    ensemble->max_events,
+    ensemble->max_bins,
+    ensemble->time_step,
+    DS_MEMORY_DEFAULT
+  );
+
+  if ( self->is_okay ) {
+    self->result  = (unsigned char *)calloc(2U, ensemble->result_size);
+
+    if ( NULL == (void *)self->result ) {
+      ERROR("Cannot allocate the results of worker %u: %s.",
+        self->index,
+        strerror(errno)
+      );
+      ds_simulator_deinitialize(&self->simulator);
+      self->is_okay = false;
+    } else {
+      self->accumulator = self->result + ensemble->result_size;
+    }
+  }
+
+  bool is_okay  = self->is_okay;
+
+  pthread_mutex_lock(&ensemble->lock);
+  ++ensemble->num_ready;
+  pthread_cond_broadcast(&ensemble->done);
+
+  if ( !is_okay ) {
+    pthread_mutex_unlock(&ensemble->lock);
+    return NULL;
+  }
+
+  unsigned int generation = ensemble->generation;
+
+  do {
+    while ( generation == ensemble->generation && !ensemble->is_stopping ) {
+      pthread_cond_wait(&ensemble->start, &ensemble->lock);
+    }
+
+    if ( ensemble->is_stopping )
+      break;
+
+    generation  = ensemble->generation;
+    pthread_mutex_unlock(&ensemble->lock);
+
+    ds_ensemble_worker_run(self);
+
+    pthread_mutex_lock(&ensemble->lock);
+    ++ensemble->num_done;
+    pthread_cond_broadcast(&ensemble->done);
+  } while ( true );
+
+  pthread_mutex_unlock(&ensemble->lock);
+
+  free(self->result);
+  ds_simulator_deinitialize(&self->simulator);
+
+  return NULL;
+}
+
+static void ds_ensemble_stop (
+  struct ds_ensemble *          self,
+  unsigned int                  num_threads
+)
+{
+  pthread_mutex_lock(&self->lock);
+  self->is_stopping = true;
+  pthread_cond_broadcast(&self->start);
+  pthread_mutex_unlock(&self->lock);
+
+  for ( unsigned int index = 0U; index < num_threads; ++index ) {
+    pthread_join(self->workers[ index ].thread, NULL);
+  }
+
+  pthread_cond_destroy(&self->done);
+  pthread_cond_destroy(&self->start);
+  pthread_mutex_destroy(&self->lock);
+  free(self->workers);
+}
+
+bool ds_ensemble_initialize (
+  struct ds_ensemble *          self,
+  unsigned int                  num_workers,
+  unsigned int                  max_events,
+  unsigned int                  max_bins,
+  unsigned int                  time_step,
+  size_t                        result_size
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == result_size ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "result_size",
+      "Out of range [1;SIZE_MAX]"
+    );
+    return false;
+  }
+
+  if ( 0U == num_workers ) {
+    long num_cores  = sysconf(_SC_NPROCESSORS_ONLN);
+    num_workers = 0L < num_cores ? (unsigned int)num_cores : 1U;
+  }
+
+  struct ds_ensemble_worker * workers
+    = (struct ds_ensemble_worker *)aligned_alloc(
+      _Alignof(struct ds_ensemble_worker),
+      (size_t)num_workers * sizeof(*workers)
+    );
+
+  if ( NULL == (void *)workers ) {
+    ERROR("Cannot allocate %u workers: %s.",
+      num_workers,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  self->workers     = workers;
+  self->num_workers = num_workers;
+  self->max_events  = max_events;
+  self->max_bins    = max_bins;
+  self->time_step   = time_step;
+  self->result_size = result_size;
+  self->replicate   = (ds_ensemble_replicate)NULL;
+  self->reduce      = (ds_ensemble_reduce)NULL;
+  self->context     = NULL;
+  self->generation  = 0U;
+  self->num_ready   = 0U;
+  self->num_done    = 0U;
+  self->is_stopping = false;
+
+  pthread_mutex_init(&self->lock, NULL);
+  pthread_cond_init(&self->start, NULL);
+  pthread_cond_init(&self->done, NULL);
+
+  unsigned int num_threads;
+
+  for ( num_threads = 0U; num_threads < num_workers; ++num_threads ) {
+    struct ds_ensemble_worker * worker  = workers + num_threads;
+
+    atomic_init(&worker->range, 0ULL);
+    worker->ensemble          = self;
+    worker->result            = (unsigned char *)NULL;
+    worker->accumulator       = (unsigned char *)NULL;
+    worker->index             = num_threads;
+    worker->num_replications  = 0U;
+    worker->is_okay           = false;
+
+    int error = pthread_create(&worker->thread, NULL, ds_ensemble_worker_main, worker);
+
+    if ( 0 != error ) {
+      ERROR("Cannot create worker %u: %s.",
+        num_threads,
+        strerror(error)
+      );
+      break;
+    }
+  }
+
+  /// wait until every worker has its simulator ready
+  pthread_mutex_lock(&self->lock);
+
+  while ( self->num_ready < num_threads ) {
+    pthread_cond_wait(&self->done, &self->lock);
+  }
+
+  pthread_mutex_unlock(&self->lock);
+
+  bool is_okay  = num_threads == num_workers;
+
+  for ( unsigned int index = 0U; index < num_threads; ++index ) {
+    is_okay = is_okay && workers[ index ].is_okay;
+  }
+
+  if ( !is_okay ) {
+    ds_ensemble_stop(self, num_threads);
+    return false;
+  }
+
+  return true;
+}
+
+void ds_ensemble_deinitialize (
+  struct ds_ensemble *          self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->workers);
+
+  ds_ensemble_stop(self, self->num_workers);
+}
+
+bool ds_ensemble_run (
+  struct ds_ensemble *          self,
+  unsigned int                  num_replications,
+  ds_ensemble_replicate         replicate,
+  ds_ensemble_reduce            reduce,
+  void *                        context,
+  void *                        result
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->workers);
+
+  if ( NULL == replicate || NULL == reduce || NULL == result ) {
+    ERROR("Invalid argument `%s`: %s.",
+      NULL == replicate ? "replicate" : NULL == reduce ? "reduce" : "result",
+      "Unexpected null pointer"
+    );
+    return false;
+  }
+
+  pthread_mutex_lock(&self->lock);
+
+  self->replicate = replicate;
+  self->reduce    = reduce;
+  self->context   = context;
+  self->num_done  = 0U;
+
+  /// deal out contiguous ranges, idle workers steal from the others later
+  for ( unsigned int index = 0U; index < self->num_workers; ++index ) {
+    unsigned int begin  = (unsigned int)(
+      (unsigned long long)num_replications * index / self->num_workers
+    );
+    unsigned int end    = (unsigned int)(
+      (unsigned long long)num_replications * ( index + 1U ) / self->num_workers
+    );
+
+    atomic_store(&self->workers[ index ].range, ds_ensemble_pack(begin, end));
+  }
+
+  ++self->generation;
+  pthread_cond_broadcast(&self->start);
+
+  while ( self->num_done < self->num_workers ) {
+    pthread_cond_wait(&self->done, &self->lock);
+  }
+
+  pthread_mutex_unlock(&self->lock);
+
+  bool is_okay  = true;
+
+  memset(result, 0, self->result_size);
+
+  for ( unsigned int index = 0U; index < self->num_workers; ++index ) {
+    struct ds_ensemble_worker * worker  = self->workers + index;
+
+    reduce(result, worker->accumulator, context);
+    is_okay = is_okay && worker->is_okay;
+  }
+
+  return is_okay;
+}
+
+/// Real Time
+
+static unsigned long long ds_clock_now ( void )
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (unsigned long long)now.tv_sec * 1000000000ULL
+    + (unsigned long long)now.tv_nsec;
+}
+
+bool ds_realtime_initialize (
+  struct ds_realtime *          self,
+  struct ds_simulator *         simulator,
+  unsigned long long            time_scale,
+  unsigned long long            spin_time
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( NULL == (void *)simulator ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "simulator",
+      "Unexpected null pointer"
+    );
+    return false;
+  }
+
+  if ( 0ULL == time_scale ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "time_scale",
+      "Out of range [1;ULLONG_MAX]"
+    );
+    return false;
+  }
+
+  /// the default 50us timer slack of the calling thread would dwarf the spin
+  if ( 0 != prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL) ) {
+    ALERT("Cannot reduce the timer slack: %s.", strerror(errno));
+  }
+
+  self->origin      = ds_clock_now();
+  self->time_origin = simulator->time;
+  self->time_scale  = time_scale;
+  self->spin_time   = spin_time;
+
+  memset(&self->stats, 0, sizeof(self->stats));
+
+  return true;
+}
+
+void ds_realtime_deinitialize (
+  struct ds_realtime *          self
+)
+{
+  assert(NULL != (void *)self);
+  assert(0ULL != self->time_scale);
+
+  (void)self;
+}
+
+unsigned long long ds_realtime_deadline (
+  struct ds_realtime *          self,
+  unsigned int                  time
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( time < self->time_origin )
+    return self->origin;
+
+  return self->origin + (unsigned long long)( time - self->time_origin ) * self->time_scale;
+}
+
+void ds_realtime_wait (
+  struct ds_realtime *          self,
+  unsigned long long            deadline
+)
+{
+  assert(NULL != (void *)self);
+
+  unsigned long long now  = ds_clock_now();
+  bool               is_late = deadline <= now;
+
+  if ( !is_late && self->spin_time < deadline - now ) {
+    /// sleep on an absolute deadline, so that wake-up delays do not add up
+    unsigned long long wake_up  = deadline - self->spin_time;
+    struct timespec    request  = {
+      .tv_sec   = (time_t)( wake_up / 1000000000ULL ),
+      .tv_nsec  = (long)( wake_up % 1000000000ULL )
+    };
+
+    while ( EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &request, NULL) ) {
+      continue;
+    }
+
+    now     = ds_clock_now();
+    is_late = deadline <= now;
+  }
+
+  while ( now < deadline ) {
+    CPU_RELAX();
+    now = ds_clock_now();
+  }
+
+  struct ds_realtime_stats * stats    = &self->stats;
+  unsigned long long         lateness = now - deadline;
+
+  ++stats->num_steps;
+  stats->num_late_steps  += is_late ? 1ULL : 0ULL;
+  stats->last_lateness    = lateness;
+  stats->total_lateness  += lateness;
+
+  if ( lateness > stats->max_lateness ) {
+    stats->max_lateness = lateness;
+  }
+}
+
+unsigned int ds_simulator_simulate_realtime (
+  struct ds_simulator *         self,
+  struct ds_realtime *          realtime
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)realtime);
+
+  unsigned int      time  = self->time;
+  struct ds_event * event = ds_event_queue_peek(&self->queue, UINT_MAX);
+
+  if ( NULL != (void *)event && event->time > time ) {
+    /// jump over the steps without any event
+    self->time  += ( event->time - time ) / self->time_step * self->time_step;
+    time         = event->time;
+  }
+
+  ds_realtime_wait(realtime, ds_realtime_deadline(realtime, time));
+
+  return ds_simulator_simulate(self);
+}
+
+/// Reactor
+
+bool ds_reactor_initialize (
+  struct ds_reactor *           self,
+  unsigned int                  max_sources
+)
+{
+  assert(NULL != (void *)self);
+
+  if ( 0U == max_sources ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "max_sources",
+      "Out of range [1;MAX_UINT]"
+    );
+    return false;
+  }
+
+  struct ds_reactor_source * sources
+    = (struct ds_reactor_source *)malloc(
+      (size_t)max_sources * sizeof(*sources)
+    );
+
+  if ( NULL == (void *)sources ) {
+    ERROR("Cannot allocate %u sources: %s.",
+      max_sources,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  int epoll_fd  = epoll_create1(EPOLL_CLOEXEC);
+
+  if ( 0 > epoll_fd ) {
+    ERROR("Cannot create the epoll instance: %s.", strerror(errno));
+    free(sources);
+    return false;
+  }
+
+  int timer_fd  = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+  if ( 0 > timer_fd ) {
+    ERROR("Cannot create the timer: %s.", strerror(errno));
+    close(epoll_fd);
+    free(sources);
+    return false;
+  }
 
-    unsigned num_drained_events = ds_simulator_drain(&simulator);
-    fprintf(stdout, "%u event%s ha%s been drained.\n",
-      num_drained_events,
-      num_drained_events == 1U  ? ""  : "s",
-      num_drained_events == 1U  ? "s" : "ve"
-    );
+  /// the timer is the only registration without a source
+  struct epoll_event timer_event  = {
+    .events = EPOLLIN,
+    .data   = { .ptr = NULL }
+  };
+
+  if ( 0 != epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &timer_event) ) {
+    ERROR("Cannot register the timer: %s.", strerror(errno));
+    close(timer_fd);
+    close(epoll_fd);
+    free(sources);
+    return false;
   }
 
-  ds_simulator_deinitialize(&simulator);
-  return exit_code;
-}
+  self->sources         = sources;
+  self->max_sources     = max_sources;
+  self->free_source     = sources;
+  self->retired_source  = (struct ds_reactor_source *)NULL;
+  self->num_sources     = 0U;
+  self->epoll_fd        = epoll_fd;
+  self->timer_fd        = timer_fd;
+  self->is_dispatching  = false;
 
-/// SOURCES
+  /// initialize the free list
 
-# include <limits.h>
-# include <assert.h>
-# include <string.h>
-# include <errno.h>
+  for ( unsigned int index = 0U; index < max_sources; ++index ) {
+    struct ds_reactor_source * source = sources + index;
 
-# define UNREACHABLE()                                                        \
-  do {                                                                        \
-    fprintf(stderr, "Unreachable point has been reached!\n");                 \
-    abort();                                                                  \
-  } while ( false )
+    source->next    = index + 1U < max_sources ? source + 1
+      : (struct ds_reactor_source *)NULL;
+    source->decode  = (ds_reactor_decode)NULL;
+    source->context = NULL;
+    source->fd      = -1;
+  }
 
-# define ERROR(format, ...)     fprintf(stderr, "[ERROR] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
-# define ALERT(format, ...)     fprintf(stderr, "[ALERT] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
-# define NOTE(format, ...)      fprintf(stderr, "[NOTE ] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
-# define INFO(format, ...)      fprintf(stderr, "[INFO ] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
-# define DEBUG(format, ...)     fprintf(stderr, "[DEBUG] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
-# define TRACE(format, ...)     fprintf(stderr, "[TRACE] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+  return true;
+}
 
-/// Event
+void ds_reactor_deinitialize (
+  struct ds_reactor *           self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->sources);
 
-bool ds_event_initialize (
-  struct ds_event *             self,
-  unsigned int                  time,
-  enum ds_event_type            type,
-  void *                        data
+  close(self->timer_fd);
+  close(self->epoll_fd);
+  free(self->sources);
+}
+
+struct ds_reactor_source * ds_reactor_register (
+  struct ds_reactor *           self,
+  int                           fd,
+  ds_reactor_decode             decode,
+  void *                        context
 )
 {
   assert(NULL != (void *)self);
+  assert(NULL != (void *)self->sources);
 
-  if ( (int)DS_NUM_EVENT_TYPES <= (int)type ) {
+  if ( 0 > fd || NULL == decode ) {
     ERROR("Invalid argument `%s`: %s.",
-      "type",
-      "Out of range [0;DS_NUM_EVENT_TYPES-1]"
+      0 > fd ? "fd" : "decode",
+      0 > fd ? "Out of range [0;INT_MAX]" : "Unexpected null pointer"
     );
-    return false;
+    return (struct ds_reactor_source *)NULL;
   }
 
-  self->next  = (struct ds_event *)NULL;
-  self->time  = time;
-  self->type  = type;
-  self->data  = data;
+  struct ds_reactor_source * source = self->free_source;
 
-  return true;
+  if ( NULL == (void *)source ) {
+    ERROR("Out of memory: Maximum number of sources (%u) has been reached.",
+      self->max_sources
+    );
+    return source;
+  }
+
+  /// level-triggered, so that data left by a decoder is reported again
+  struct epoll_event event  = {
+    .events = EPOLLIN,
+    .data   = { .ptr = source }
+  };
+
+  if ( 0 != epoll_ctl(self->epoll_fd, EPOLL_CTL_ADD, fd, &event) ) {
+    ERROR("Cannot register descriptor %d: %s.",
+      fd,
+      strerror(errno)
+    );
+    return (struct ds_reactor_source *)NULL;
+  }
+
+  self->free_source = source->next;
+  ++self->num_sources;
+
+  source->next    = (struct ds_reactor_source *)NULL;
+  source->decode  = decode;
+  source->context = context;
+  source->fd      = fd;
+
+  return source;
 }
 
-void ds_event_deinitialize (
-  struct ds_event *             self
+void ds_reactor_unregister (
+  struct ds_reactor *           self,
+  struct ds_reactor_source *    source
 )
 {
   assert(NULL != (void *)self);
-  assert(NULL == (void *)self->next);
-  assert((int)DS_NUM_EVENT_TYPES > (int)self->type);
+  assert(NULL != (void *)source);
+  assert(0 <= source->fd);
 
-  self->next  = (struct ds_event *)NULL;
-  self->time  = 0U;
-  self->type  = DS_NUM_EVENT_TYPES;
-  self->data  = NULL;
+  if ( 0 != epoll_ctl(self->epoll_fd, EPOLL_CTL_DEL, source->fd, NULL) ) {
+    ALERT("Cannot unregister descriptor %d: %s.",
+      source->fd,
+      strerror(errno)
+    );
+  }
+
+  source->decode    = (ds_reactor_decode)NULL;
+  source->context   = NULL;
+  source->fd        = -1;
+  --self->num_sources;
+
+  /// a later entry of the batch may still refer to the slot
+  if ( self->is_dispatching ) {
+    source->next          = self->retired_source;
+    self->retired_source  = source;
+    return;
+  }
+
+  source->next      = self->free_source;
+  self->free_source = source;
 }
 
-bool ds_event_process (
-  struct ds_event *             self
+static void ds_reactor_catch_up (
+  struct ds_simulator *         simulator,
+  struct ds_realtime *          realtime
+)
+{
+  /// move to the step of the wall-clock time, never past a pending event
+  unsigned long long now    = ds_clock_now();
+
+  if ( now <= realtime->origin )
+    return;
+
+  unsigned long long time   = realtime->time_origin
+    + ( now - realtime->origin ) / realtime->time_scale;
+  struct ds_event *  event  = ds_event_queue_peek(&simulator->queue, UINT_MAX);
+
+  if ( NULL != (void *)event && event->time < time ) {
+    time  = event->time;
+  }
+
+  if ( time > UINT_MAX ) {
+    time  = UINT_MAX;
+  }
+
+  if ( time > simulator->time ) {
+    simulator->time += ( (unsigned int)time - simulator->time )
+      / simulator->time_step * simulator->time_step;
+  }
+}
+
+unsigned int ds_simulator_simulate_reactive (
+  struct ds_simulator *         self,
+  struct ds_reactor *           reactor,
+  struct ds_realtime *          realtime
 )
 {
   assert(NULL != (void *)self);
-  assert(NULL == (void *)self->next);
-  assert((int)DS_NUM_EVENT_TYPES > (int)self->type);
+  assert(NULL != (void *)reactor);
+  assert(NULL != (void *)realtime);
 
-  bool is_okay  = ds_event_display(self, stdout);
-  assert(is_okay);
-  (void)is_okay;
+  struct epoll_event events [ DS_REACTOR_BATCH_SIZE ];
 
-  if ( DS_EVENT_TYPE_CUSTOM == self->type && NULL != self->data ) {
-    struct ds_simulator * simulator = (struct ds_simulator *)self->data;
+  do {
+    struct ds_event * event       = ds_event_queue_peek(&self->queue, UINT_MAX);
+    bool              is_pending  = NULL != (void *)event || !ds_simulator_is_empty(self);
 
-    DEBUG(">>> (Re)Scheduling event <%p>...", self);
-    bool is_okay  = ds_simulator_schedule(simulator,
-      self->time + 10U,
-      self->type,
-      self->data
-    );
-    DEBUG("... %scheduled event <%p> @ %u.",
-      is_okay ? "(Re)S" : "Not (re)s",
-      self,
-      self->time + 10U
+    if ( !is_pending && 0U == reactor->num_sources )
+      break;
+
+    /// wake up early enough to spin; a zero timer blocks on descriptors only
+    struct itimerspec timer = { 0 };
+
+    if ( is_pending ) {
+      /// spilled events are only known to come after the current step
+      unsigned long long deadline = ds_realtime_deadline(realtime,
+        NULL != (void *)event && event->time > self->time ? event->time : self->time
+      );
+      unsigned long long wake_up  = deadline > realtime->spin_time
+        ? deadline - realtime->spin_time : 1ULL;
+
+      timer.it_value.tv_sec   = (time_t)( wake_up / 1000000000ULL );
+      timer.it_value.tv_nsec  = (long)( wake_up % 1000000000ULL );
+
+      if ( 0 == timer.it_value.tv_sec && 0L == timer.it_value.tv_nsec ) {
+        timer.it_value.tv_nsec  = 1L;
+      }
+    }
+
+    if ( 0 != timerfd_settime(reactor->timer_fd, TFD_TIMER_ABSTIME, &timer, NULL) ) {
+      ERROR("Cannot arm the timer: %s.", strerror(errno));
+      break;
+    }
+
+    int num_ready = epoll_wait(reactor->epoll_fd,
+      events,
+      (int)DS_REACTOR_BATCH_SIZE,
+      -1
     );
-  }
 
-  return false;
+    if ( 0 > num_ready ) {
+      if ( EINTR == errno )
+        continue;
+
+      ERROR("Cannot wait for events: %s.", strerror(errno));
+      break;
+    }
+
+    ds_reactor_catch_up(self, realtime);
+
+    bool is_due = false;
+
+    reactor->is_dispatching = true;
+
+    for ( int index = 0; index < num_ready; ++index ) {
+      struct ds_reactor_source * source
+        = (struct ds_reactor_source *)events[ index ].data.ptr;
+
+      if ( NULL == (void *)source ) {
+        unsigned long long num_expirations;
+
+        if ( 0 > read(reactor->timer_fd, &num_expirations, sizeof(num_expirations))
+          && EAGAIN != errno ) {
+          ALERT("Cannot read the timer: %s.", strerror(errno));
+        }
+
+        is_due  = true;
+        continue;
+      }
+
+      /// unregistered by a previous decoder of this batch
+      if ( 0 > source->fd )
+        continue;
+
+      if ( !source->decode(self, source->fd, source->context) ) {
+        ds_reactor_unregister(reactor, source);
+      }
+    }
+
+    reactor->is_dispatching = false;
+
+    /// no entry refers to the slots unregistered during the batch anymore
+    while ( NULL != (void *)reactor->retired_source ) {
+      struct ds_reactor_source * source = reactor->retired_source;
+
+      reactor->retired_source = source->next;
+      source->next            = reactor->free_source;
+      reactor->free_source    = source;
+    }
+
+    if ( is_due )
+      break;
+  } while ( true );
+
+  return ds_simulator_simulate_realtime(self, realtime);
 }
 
-bool ds_event_display (
-  struct ds_event *             self,
-  FILE *                        file
+/// Telemetry
+
+bool ds_telemetry_initialize (
+  struct ds_telemetry *         self,
+  char const *                  name
 )
 {
   assert(NULL != (void *)self);
-  assert(NULL == (void *)self->next);
-  assert((int)DS_NUM_EVENT_TYPES > (int)self->type);
 
-  if ( NULL == (void *)file ) {
+  _Static_assert(DS_TELEMETRY_MAX_TYPES >= DS_NUM_EVENT_TYPES, "Too many event types");
+
+  if ( NULL == (void *)name ) {
+    snprintf(self->name, sizeof(self->name), "/ash-%ld", (long)getpid());
+  } else if ( sizeof(self->name) <= strlen(name) ) {
     ERROR("Invalid argument `%s`: %s.",
-      "file",
-      "Unexpected null pointer"
+      "name",
+      "Too long"
     );
     return false;
+  } else {
+    strcpy(self->name, name);
   }
 
-  static char const * types []  = {
-    [ DS_EVENT_TYPE_CUSTOM ]  = "CUSTOM"
-  };
+  int fd  = shm_open(self->name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+
+  if ( 0 > fd ) {
+    ERROR("Cannot create shared memory `%s`: %s.",
+      self->name,
+      strerror(errno)
+    );
+    return false;
+  }
+
+  void * segment  = MAP_FAILED;
+
+  if ( 0 == ftruncate(fd, (off_t)sizeof(*self->segment)) ) {
+    segment = mmap(NULL,
+      sizeof(*self->segment),
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED,
+      fd,
+      0
+    );
+  }
+
+  if ( MAP_FAILED == segment ) {
+    ERROR("Cannot map shared memory `%s`: %s.",
+      self->name,
+      strerror(errno)
+    );
+    close(fd);
+    shm_unlink(self->name);
+    return false;
+  }
+
+  /// the mapping outlives the descriptor
+  close(fd);
+
+  self->segment           = (struct ds_telemetry_segment *)segment;
+  self->num_steps         = 0ULL;
+  self->clock             = ds_clock_now();
+  self->num_events        = 0ULL;
+  self->events_per_second = 0ULL;
+
+  self->segment->version    = DS_TELEMETRY_VERSION;
+  self->segment->pid        = (uint32_t)getpid();
+  self->segment->num_types  = (uint32_t)DS_NUM_EVENT_TYPES;
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    strncpy(self->segment->type_names[ type ], ds_event_types[ type ], DS_TELEMETRY_NAME_SIZE - 1U);
+  }
+
+  /// the rest is zero: readers only trust a segment once it has its magic
+  atomic_store_explicit(&self->segment->magic, DS_TELEMETRY_MAGIC, memory_order_release);
+
+  return true;
+}
+
+void ds_telemetry_deinitialize (
+  struct ds_telemetry *         self
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)self->segment);
+
+  munmap(self->segment, sizeof(*self->segment));
+  shm_unlink(self->name);
+}
+
+void ds_telemetry_publish (
+  struct ds_telemetry *         self,
+  struct ds_simulator *         simulator
+)
+{
+  assert(NULL != (void *)self);
+  assert(NULL != (void *)simulator);
+
+  struct ds_telemetry_segment * segment = self->segment;
+  unsigned long long            num_events  = 0ULL;
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    num_events  += simulator->num_type_events[ type ];
+  }
+
+  /// the clock is only read once in a while
+  if ( 0ULL == ++self->num_steps % DS_TELEMETRY_RATE_PERIOD ) {
+    unsigned long long clock  = ds_clock_now();
 
-  int num_chars = fprintf(file, "Event <%p>: next=<%p> type=%s data=<%p> @ %u\n",
-    self,
-    self->next,
-    types[ (int)self->type ],
-    self->data,
-    self->time
+    if ( clock > self->clock && num_events >= self->num_events ) {
+      self->events_per_second = ( num_events - self->num_events ) * 1000000000ULL
+        / ( clock - self->clock );
+    }
+
+    self->clock       = clock;
+    self->num_events  = num_events;
+  }
+
+  uint64_t sequence = atomic_load_explicit(&segment->sequence, memory_order_relaxed);
+
+  atomic_store_explicit(&segment->sequence, sequence + 1U, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+
+  atomic_store_explicit(&segment->time, simulator->time, memory_order_relaxed);
+  atomic_store_explicit(&segment->time_step, simulator->time_step, memory_order_relaxed);
+  atomic_store_explicit(&segment->num_steps, self->num_steps, memory_order_relaxed);
+  atomic_store_explicit(&segment->num_events, num_events, memory_order_relaxed);
+  atomic_store_explicit(&segment->events_per_second, self->events_per_second, memory_order_relaxed);
+  /// the spilled events are pending as well
+  atomic_store_explicit(&segment->num_pending_events,
+    ds_simulator_count_events(simulator)
+      + ( NULL == (void *)simulator->spill ? 0ULL : simulator->spill->num_pending ),
+    memory_order_relaxed
   );
+  atomic_store_explicit(&segment->num_bins, simulator->queue.num_bins, memory_order_relaxed);
+  atomic_store_explicit(&segment->max_events, simulator->queue.events.max_events, memory_order_relaxed);
+  atomic_store_explicit(&segment->max_bins, simulator->queue.bins.max_bins, memory_order_relaxed);
+
+  for ( int type = 0; type < (int)DS_NUM_EVENT_TYPES; ++type ) {
+    atomic_store_explicit(segment->num_type_events + type,
+      simulator->num_type_events[ type ],
+      memory_order_relaxed
+    );
+  }
 
-  return num_chars > 0;
+  atomic_store_explicit(&segment->sequence, sequence + 2U, memory_order_release);
 }
 
-/// Event Pool
+/// Sink
 
-bool ds_event_pool_initialize (
-  struct ds_event_pool *        self,
-  unsigned int                  max_events
+static bool ds_sink_write_all (
+  int                           fd,
+  struct iovec *                vectors,
+  int                           num_vectors
+)
+{
+  while ( 0 < num_vectors ) {
+    ssize_t num_bytes = writev(fd, vectors, num_vectors);
+
+    if ( 0 > num_bytes ) {
+      if ( EINTR == errno )
+        continue;
+
+      ERROR("Cannot write to descriptor %d: %s.",
+        fd,
+        strerror(errno)
+      );
+      return false;
+    }
+
+    /// skip what has been written, resuming partial writes
+    while ( 0 < num_vectors && (size_t)num_bytes >= vectors->iov_len ) {
+      num_bytes -= (ssize_t)vectors->iov_len;
+      ++vectors;
+      --num_vectors;
+    }
+
+    if ( 0 < num_vectors ) {
+      vectors->iov_base  = (char *)vectors->iov_base + num_bytes;
+      vectors->iov_len  -= (size_t)num_bytes;
+    }
+  }
+
+  return true;
+}
+
+static void * ds_sink_main (
+  void *                        argument
+)
+{
+  struct ds_sink * self = (struct ds_sink *)argument;
+
+  pthread_mutex_lock(&self->lock);
+
+  do {
+    while ( 0U == self->num_pending && !self->is_stopping ) {
+      pthread_cond_wait(&self->filled, &self->lock);
+    }
+
+    if ( 0U == self->num_pending )
+      break;
+
+    /// write the pending buffers, oldest first, in a single call
+    unsigned int  num_pending = self->num_pending;
+    unsigned int  next        = self->next;
+    struct iovec  vectors [ 2 ];
+
+    for ( unsigned int index = 0U; index < num_pending; ++index ) {
+      vectors[ index ].iov_base = self->buffers[ ( next + index ) & 1U ];
+      vectors[ index ].iov_len  = self->sizes[ ( next + index ) & 1U ];
+    }
+
+    pthread_mutex_unlock(&self->lock);
+
+    bool is_okay  = ds_sink_write_all(self->fd, vectors, (int)num_pending);
+
+    pthread_mutex_lock(&self->lock);
+
+    for ( unsigned int index = 0U; index < num_pending; ++index ) {
+      self->sizes[ ( next + index ) & 1U ]  = 0U;
+    }
+
+    self->next          = ( next + num_pending ) & 1U;
+    self->num_pending  -= num_pending;
+    self->is_okay       = self->is_okay && is_okay;
+    pthread_cond_broadcast(&self->flushed);
+  } while ( true );
+
+  pthread_mutex_unlock(&self->lock);
+
+  return NULL;
+}
+
+static bool ds_sink_submit (
+  struct ds_sink *              self
+)
+{
+  pthread_mutex_lock(&self->lock);
+
+  /// backpressure: the other buffer is still being written
+  if ( 0U != self->num_pending ) {
+    ++self->num_stalls;
+
+    while ( 0U != self->num_pending ) {
+      pthread_cond_wait(&self->flushed, &self->lock);
+    }
+  }
+
+  self->next        = self->active;
+  self->num_pending = 1U;
+  self->active     ^= 1U;
+
+  bool is_okay  = self->is_okay;
+
+  pthread_cond_signal(&self->filled);
+  pthread_mutex_unlock(&self->lock);
+
+  return is_okay;
+}
+
+bool ds_sink_initialize (
+  struct ds_sink *              self,
+  int                           fd,
+  enum ds_event_format          format,
+  size_t                        capacity
 )
 {
   assert(NULL != (void *)self);
 
-  if ( 0U == max_events ) {
+  if ( 0 > fd ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "fd",
+      "Out of range [0;INT_MAX]"
+    );
+    return false;
+  }
+
+  if ( (int)DS_NUM_EVENT_FORMATS <= (int)format ) {
     ERROR("Invalid argument `%s`: %s.",
-      "max_events",
-      "Out of range [1;MAX_UINT]"
+      "format",
+      "Out of range [0;DS_NUM_EVENT_FORMATS-1]"
     );
     return false;
   }
 
-  struct ds_event * events
-    = (struct ds_event *)malloc(
-      (size_t)max_events * sizeof(*events)
+  if ( 256U > capacity ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "capacity",
+      "Out of range [256;SIZE_MAX]"
     );
+    return false;
+  }
 
-  if ( NULL == (void *)events ) {
-    ERROR("Cannot allocate %u events: %s.",
-      max_events,
+  char * buffers  = (char *)malloc(2U * capacity);
+
+  if ( NULL == (void *)buffers ) {
+    ERROR("Cannot allocate %zu bytes of buffers: %s.",
+      2U * capacity,
       strerror(errno)
     );
     return false;
   }
 
-  self->events      = events;
-  self->max_events  = max_events;
-  self->free_event  = events;
-
-  /// initialize the free list
-
-  events->next  = (struct ds_event *)NULL;
-
-  for ( unsigned int index  = 1U; index < max_events; ++index ) {
-    struct ds_event * prev  = events + index - 1U;
-    struct ds_event * curr  = events + index;
+  self->buffers[ 0 ]  = buffers;
+  self->buffers[ 1 ]  = buffers + capacity;
+  self->sizes[ 0 ]    = 0U;
+  self->sizes[ 1 ]    = 0U;
+  self->capacity      = capacity;
+  self->active        = 0U;
+  self->next          = 0U;
+  self->num_pending   = 0U;
+  self->format        = format;
+  self->fd            = fd;
+  self->num_stalls    = 0ULL;
+  self->is_stopping   = false;
+  self->is_okay       = true;
+
+  pthread_mutex_init(&self->lock, NULL);
+  pthread_cond_init(&self->filled, NULL);
+  pthread_cond_init(&self->flushed, NULL);
+
+  int error = pthread_create(&self->thread, NULL, ds_sink_main, self);
+
+  if ( 0 != error ) {
+    ERROR("Cannot create the sink thread: %s.", strerror(error));
+    pthread_cond_destroy(&self->flushed);
+    pthread_cond_destroy(&self->filled);
+    pthread_mutex_destroy(&self->lock);
+    free(buffers);
+    return false;
+  }
 
-    prev->next  = curr;
-    curr->next  = (struct ds_event *)NULL;
+  if ( DS_EVENT_FORMAT_CSV == format ) {
+    ds_sink_printf(self, "time,type,data\n");
   }
 
   return true;
 }
 
-void ds_event_pool_deinitialize (
-  struct ds_event_pool *        self
-)
-{
-  assert(NULL != (void *)self);
-  assert(NULL != (void *)self->events);
-  assert(0U != self->max_events);
-
-  free(self->events);
-}
-
-struct ds_event * ds_event_pool_acquire (
-  struct ds_event_pool *        self,
-  unsigned int                  time,
-  enum ds_event_type            type,
-  void *                        data
+bool ds_sink_deinitialize (
+  struct ds_sink *              self
 )
 {
   assert(NULL != (void *)self);
-  assert(NULL != (void *)self->events);
-  assert(0U != self->max_events);
-
-  struct ds_event * event = self->free_event;
+  assert(NULL != (void *)self->buffers[ 0 ]);
 
-  if ( NULL == (void *)event ) {
-    ERROR("Out of memory: Maximum number of events (%u) has been reached.",
-      self->max_events
-    );
-    return event;
-  }
+  bool is_okay  = ds_sink_flush(self);
 
-  struct ds_event * free_event  = event->next;
+  pthread_mutex_lock(&self->lock);
+  self->is_stopping = true;
+  pthread_cond_signal(&self->filled);
+  pthread_mutex_unlock(&self->lock);
 
-  bool is_okay  = ds_event_initialize(event,
-    time,
-    type,
-    data
-  );
+  pthread_join(self->thread, NULL);
 
-  if ( !is_okay )
-    return (struct ds_event *)NULL;
+  pthread_cond_destroy(&self->flushed);
+  pthread_cond_destroy(&self->filled);
+  pthread_mutex_destroy(&self->lock);
+  free(self->buffers[ 0 ]);
 
-  self->free_event  = free_event;
-  return event;
+  return is_okay;
 }
 
-void ds_event_pool_release (
-  struct ds_event_pool *        self,
-  struct ds_event *             event
+bool ds_sink_write (
+  struct ds_sink *              self,
+  void const *                  data,
+  size_t                        size
 )
 {
   assert(NULL != (void *)self);
-  assert(NULL != (void *)self->events);
-  assert(0U != self->max_events);
+  assert(NULL != data || 0U == size);
 
-  assert(NULL != (void *)event);
-  assert(NULL == (void *)event->next);
+  unsigned char const * bytes = (unsigned char const *)data;
 
-  ds_event_deinitialize(event);
-  event->next       = self->free_event;
-  self->free_event  = event;
-}
+  while ( 0U < size ) {
+    size_t free_size  = self->capacity - self->sizes[ self->active ];
 
-/// Event List
+    if ( 0U == free_size ) {
+      if ( !ds_sink_submit(self) )
+        return false;
 
-void ds_event_list_initialize (
-  struct ds_event_list *        self
-)
-{
-  assert(NULL != (void *)self);
+      continue;
+    }
 
-  self->head = (struct ds_event *)NULL;
-  self->tail = (struct ds_event *)NULL;
-}
+    size_t num_bytes  = size < free_size ? size : free_size;
 
-void ds_event_list_deinitialize (
-  struct ds_event_list *        self
-)
-{
-  assert(NULL != (void *)self);
-  assert(NULL == (void *)self->head);
-  assert(NULL == (void *)self->tail);
+    memcpy(self->buffers[ self->active ] + self->sizes[ self->active ], bytes, num_bytes);
+    self->sizes[ self->active ]  += num_bytes;
+    bytes                        += num_bytes;
+    size                         -= num_bytes;
+  }
 
-  (void)self;
+  return true;
 }
 
-void ds_event_list_insert (
-  struct ds_event_list *        self,
+bool ds_sink_write_event (
+  struct ds_sink *              self,
   struct ds_event *             event
 )
 {
   assert(NULL != (void *)self);
   assert(NULL != (void *)event);
-  assert(NULL == (void *)event->next);
 
-  if ( NULL == (void *)self->head ) {
-    self->head  = event;
-    self->tail  = event;
-  } else {
-    self->tail->next  = event;
-    self->tail  = event;
+  /// format in place, submitting the buffer when the record does not fit
+  for ( unsigned int attempt = 0U; attempt < 2U; ++attempt ) {
+    size_t free_size  = self->capacity - self->sizes[ self->active ];
+    int    num_chars  = ds_event_serialize(event,
+      self->format,
+      self->buffers[ self->active ] + self->sizes[ self->active ],
+      free_size
+    );
+
+    if ( 0 > num_chars )
+      return false;
+
+    /// text formats need room for the terminator as well
+    size_t size = (size_t)num_chars
+      + ( DS_EVENT_FORMAT_BINARY == self->format ? 0U : 1U );
+
+    if ( size <= free_size ) {
+      self->sizes[ self->active ] += (size_t)num_chars;
+      return true;
+    }
+
+    if ( !ds_sink_submit(self) )
+      return false;
   }
+
+  ERROR("Record of event <%p> exceeds the sink capacity (%zu).",
+    (void *)event,
+    self->capacity
+  );
+  return false;
 }
 
-struct ds_event * ds_event_list_remove (
-  struct ds_event_list *        self
+bool ds_sink_printf (
+  struct ds_sink *              self,
+  char const *                  format,
+  ...
 )
 {
   assert(NULL != (void *)self);
+  assert(NULL != (void *)format);
 
-  struct ds_event * event = self->head;
+  for ( unsigned int attempt = 0U; attempt < 2U; ++attempt ) {
+    size_t  free_size = self->capacity - self->sizes[ self->active ];
+    va_list arguments;
 
-  if ( NULL == (void *)event )
-    return event;
+    va_start(arguments, format);
+    int num_chars = vsnprintf(self->buffers[ self->active ] + self->sizes[ self->active ],
+      free_size,
+      format,
+      arguments
+    );
+    va_end(arguments);
 
-  self->head  = event->next;
-  event->next = (struct ds_event *)NULL;
+    if ( 0 > num_chars )
+      return false;
 
-  if ( NULL == (void *)self->head ) {
-    self->tail  = self->head;
+    if ( (size_t)num_chars < free_size ) {
+      self->sizes[ self->active ] += (size_t)num_chars;
+      return true;
+    }
+
+    if ( !ds_sink_submit(self) )
+      return false;
   }
 
-  return event;
+  ERROR("Message exceeds the sink capacity (%zu).", self->capacity);
+  return false;
 }
 
-bool ds_event_list_is_empty (
-  struct ds_event_list *        self
+bool ds_sink_flush (
+  struct ds_sink *              self
 )
 {
   assert(NULL != (void *)self);
 
-  return NULL == (void *)self->head;
-}
+  pthread_mutex_lock(&self->lock);
 
-/// Event Bin
+  if ( 0U != self->sizes[ self->active ] ) {
+    /// hand the active buffer over as well, behind any pending one
+    if ( 0U == self->num_pending ) {
+      self->next  = self->active;
+    }
 
-bool ds_event_bin_initialize (
-  struct ds_event_bin *         self,
-  struct ds_event *             event
-)
-{
-  assert(NULL != (void *)self);
+    ++self->num_pending;
+    pthread_cond_signal(&self->filled);
+  }
 
-  if ( NULL == (void *)event ) {
-    ERROR("Invalid argument `%s`: %s.",
-      "event",
-      "Unexpected null pointer"
-    );
-    return false;
+  while ( 0U != self->num_pending ) {
+    pthread_cond_wait(&self->flushed, &self->lock);
   }
 
-  ds_event_list_initialize(&self->events);
-  self->next  = (struct ds_event_bin *)NULL;
-  self->time  = event->time;
+  bool is_okay  = self->is_okay;
 
-  /// insert the first event
-  ds_event_list_insert(&self->events, event);
+  pthread_mutex_unlock(&self->lock);
 
-  return true;
+  return is_okay;
 }
 
-void ds_event_bin_deinitialize (
-  struct ds_event_bin *         self
-)
-{
-  assert(NULL != (void *)self);
-  assert(NULL == (void *)self->next);
+/// Spill
 
-  ds_event_list_deinitialize(&self->events);
-}
+struct ds_spill_cursor {
+  struct ds_spill_record const * records;
+  size_t                        num_records;
+  size_t *                      index;
+};
 
-void ds_event_bin_insert (
-  struct ds_event_bin *         self,
-  struct ds_event *             event
+static int ds_spill_record_compare (
+  void const *                  left,
+  void const *                  right
 )
 {
-  assert(NULL != (void *)self);
+  struct ds_spill_record const * lhs = (struct ds_spill_record const *)left;
+  struct ds_spill_record const * rhs = (struct ds_spill_record const *)right;
+
+  if ( lhs->time != rhs->time )
+    return lhs->time < rhs->time ? -1 : 1;
+
+  if ( lhs->sequence != rhs->sequence )
+    return lhs->sequence < rhs->sequence ? -1 : 1;
 
-  ds_event_list_insert(&self->events, event);
+  return 0;
 }
 
-struct ds_event * ds_event_bin_remove (
-  struct ds_event_bin *         self
+static bool ds_spill_cursor_is_before (
+  struct ds_spill_cursor *      lhs,
+  struct ds_spill_cursor *      rhs
 )
 {
-  assert(NULL != (void *)self);
-
-  return ds_event_list_remove(&self->events);
+  return 0 > ds_spill_record_compare(lhs->records + *lhs->index, rhs->records + *rhs->index);
 }
 
-bool ds_event_bin_is_empty (
-  struct ds_event_bin *         self
+static void ds_spill_heapify (
+  struct ds_spill_cursor *      cursors,
+  unsigned int                  num_cursors,
+  unsigned int                  index
 )
 {
-  assert(NULL != (void *)self);
+  do {
+    unsigned int min_index  = index;
+    unsigned int left       = 2U * index + 1U;
+    unsigned int right      = 2U * index + 2U;
 
-  return ds_event_list_is_empty(&self->events);
-}
+    if ( left < num_cursors && ds_spill_cursor_is_before(cursors + left, cursors + min_index) ) {
+      min_index = left;
+    }
 
-/// Event Bin Pool
+    if ( right < num_cursors && ds_spill_cursor_is_before(cursors + right, cursors + min_index) ) {
+      min_index = right;
+    }
 
-bool ds_event_bin_pool_initialize (
-  struct ds_event_bin_pool *    self,
-  unsigned int                  max_bins
+    if ( min_index == index )
+      return;
+
+    struct ds_spill_cursor cursor = cursors[ index ];
+    cursors[ index ]      = cursors[ min_index ];
+    cursors[ min_index ]  = cursor;
+    index = min_index;
+  } while ( true );
+}
+
+static unsigned int ds_spill_build (
+  struct ds_spill_cursor *      cursors,
+  unsigned int                  num_cursors,
+  unsigned long long            time_limit
 )
 {
-  assert(NULL != (void *)self);
+  /// heap of the cursors with records before `time_limit` (excluded)
+  unsigned int num_heap = 0U;
 
-  if ( 0U == max_bins ) {
-    ERROR("Invalid argument `%s`: %s.",
-      "max_bins",
-      "Out of range [1;MAX_UINT]"
-    );
-    return false;
-  }
+  for ( unsigned int index = 0U; index < num_cursors; ++index ) {
+    struct ds_spill_cursor * cursor = cursors + index;
 
-  struct ds_event_bin * bins
-    = (struct ds_event_bin *)malloc(
-      (size_t)max_bins * sizeof(*bins)
-    );
+    if ( *cursor->index < cursor->num_records
+      && cursor->records[ *cursor->index ].time < time_limit ) {
+      cursors[ num_heap++ ] = *cursor;
+    }
+  }
 
-  if ( NULL == (void *)bins ) {
-    ERROR("Cannot allocate %u bins: %s.",
-      max_bins,
-      strerror(errno)
-    );
-    return false;
+  for ( unsigned int index = num_heap / 2U; 0U < index--; ) {
+    ds_spill_heapify(cursors, num_heap, index);
   }
 
-  self->bins      = bins;
-  self->max_bins  = max_bins;
-  self->free_bin  = bins;
+  return num_heap;
+}
 
-  /// initialize the free list
+static unsigned int ds_spill_advance (
+  struct ds_spill_cursor *      cursors,
+  unsigned int                  num_heap,
+  unsigned long long            time_limit
+)
+{
+  /// move past the earliest record, dropping its cursor once exhausted
+  struct ds_spill_cursor * cursor = cursors;
 
-  bins->next  = (struct ds_event_bin *)NULL;
+  if ( ++*cursor->index == cursor->num_records
+    || cursor->records[ *cursor->index ].time >= time_limit ) {
+    cursors[ 0 ] = cursors[ --num_heap ];
+  }
 
-  for ( unsigned int index  = 1U; index < max_bins; ++index ) {
-    struct ds_event_bin * prev  = bins + index - 1U;
-    struct ds_event_bin * curr  = bins + index;
+  ds_spill_heapify(cursors, num_heap, 0U);
 
-    prev->next  = curr;
-    curr->next  = (struct ds_event_bin *)NULL;
+  return num_heap;
+}
+
+static bool ds_spill_merge (
+  struct ds_spill_cursor *      cursors,
+  unsigned int                  num_cursors,
+  unsigned long long            time_limit,
+  struct ds_spill_record **     records,
+  size_t *                      num_records,
+  size_t *                      max_records
+)
+{
+  /// k-way merge of the sorted cursors, up to `time_limit` (excluded)
+  unsigned int num_heap = ds_spill_build(cursors, num_cursors, time_limit);
+
+  while ( 0U < num_heap ) {
+    struct ds_spill_cursor * cursor = cursors;
+
+    if ( *num_records == *max_records ) {
+      size_t max_size = 0U == *max_records ? 1024U : 2U * *max_records;
+      struct ds_spill_record * buffer
+        = (struct ds_spill_record *)realloc(*records, max_size * sizeof(**records));
+
+      if ( NULL == (void *)buffer ) {
+        ERROR("Cannot allocate %zu spilled records: %s.",
+          max_size,
+          strerror(errno)
+        );
+        return false;
+      }
+
+      *records      = buffer;
+      *max_records  = max_size;
+    }
+
+    ( *records )[ ( *num_records )++ ] = cursor->records[ *cursor->index ];
+    num_heap  = ds_spill_advance(cursors, num_heap, time_limit);
   }
 
   return true;
 }
 
-void ds_event_bin_pool_deinitialize (
-  struct ds_event_bin_pool *    self
+static struct ds_spill_record * ds_spill_map (
+  struct ds_spill *             self,
+  size_t                        num_records
 )
 {
-  assert(NULL != (void *)self);
-  assert(NULL != (void *)self->bins);
-  assert(0U != self->max_bins);
+  if ( 0U == num_records )
+    return (struct ds_spill_record *)NULL;
+
+  void * records  = mmap(NULL,
+    num_records * sizeof(struct ds_spill_record),
+    PROT_READ,
+    MAP_SHARED,
+    self->fd,
+    0
+  );
+
+  if ( MAP_FAILED == records ) {
+    ERROR("Cannot map %zu spilled records: %s.",
+      num_records,
+      strerror(errno)
+    );
+    return (struct ds_spill_record *)NULL;
+  }
+
+  madvise(records, num_records * sizeof(struct ds_spill_record), MADV_SEQUENTIAL);
 
-  free(self->bins);
+  return (struct ds_spill_record *)records;
 }
 
-struct ds_event_bin * ds_event_bin_pool_acquire (
-  struct ds_event_bin_pool *    self,
-  struct ds_event *             event
+static bool ds_spill_stage (
+  struct ds_spill *             self
 )
 {
-  assert(NULL != (void *)self);
-  assert(NULL != (void *)self->bins);
-  assert(0U != self->max_bins);
+  /// merge the runs known at request time into the staging area
+  unsigned int num_runs     = self->num_staging_runs;
+  size_t       num_records  = self->num_staging_records;
 
-  struct ds_event_bin * bin = self->free_bin;
+  self->num_staged  = 0U;
 
-  if ( NULL == (void *)bin ) {
-    ERROR("Out of memory: Maximum number of event bins (%u) has been reached.",
-      self->max_bins
-    );
-    return bin;
-  }
+  if ( 0U == num_runs )
+    return true;
 
-  struct ds_event_bin * free_bin  = bin->next;
+  struct ds_spill_record * records = ds_spill_map(self, num_records);
+
+  if ( NULL == (void *)records )
+    return false;
 
-  bool is_okay  = ds_event_bin_initialize(bin, event);
+  struct ds_spill_cursor * cursors
+    = (struct ds_spill_cursor *)malloc(num_runs * sizeof(*cursors));
 
-  if ( !is_okay )
-    return (struct ds_event_bin *)NULL;
+  bool is_okay  = NULL != (void *)cursors;
+
+  if ( is_okay ) {
+    for ( unsigned int index = 0U; index < num_runs; ++index ) {
+      struct ds_spill_run * run = self->runs + index;
+
+      cursors[ index ].records      = records + run->offset;
+      cursors[ index ].num_records  = run->num_records;
+      cursors[ index ].index        = &run->index;
+    }
+
+    is_okay = ds_spill_merge(cursors,
+      num_runs,
+      self->staging_horizon,
+      &self->staging,
+      &self->num_staged,
+      &self->max_staged
+    );
+  } else {
+    ERROR("Cannot allocate %u cursors: %s.",
+      num_runs,
+      strerror(errno)
+    );
+  }
 
-  self->free_bin  = free_bin;
-  return bin;
+  free(cursors);
+  munmap(records, num_records * sizeof(struct ds_spill_record));
+
+  return is_okay;
 }
 
-void ds_event_bin_pool_release (
-  struct ds_event_bin_pool *    self,
-  struct ds_event_bin *         bin
+static void * ds_spill_main (
+  void *                        argument
 )
 {
-  assert(NULL != (void *)self);
-  assert(NULL != (void *)self->bins);
-  assert(0U != self->max_bins);
+  struct ds_spill * self  = (struct ds_spill *)argument;
 
-  assert(NULL != (void *)bin);
-  assert(NULL == (void *)bin->next);
+  pthread_mutex_lock(&self->lock);
 
-  ds_event_bin_deinitialize(bin);
-  bin->next       = self->free_bin;
-  self->free_bin  = bin;
-}
+  do {
+    while ( !self->is_staging && !self->is_stopping ) {
+      pthread_cond_wait(&self->start, &self->lock);
+    }
 
-/// Event Queue
+    if ( !self->is_staging )
+      break;
 
-bool ds_event_queue_initialize (
-  struct ds_event_queue *       self,
-  unsigned int                  max_events,
-  unsigned int                  max_bins
-)
-{
-  assert(NULL != (void *)self);
+    pthread_mutex_unlock(&self->lock);
 
-  bool is_okay;
+    bool is_okay  = ds_spill_stage(self);
 
-  is_okay = ds_event_pool_initialize(&self->events, max_events);
+    pthread_mutex_lock(&self->lock);
+    self->is_staging  = false;
+    self->is_okay     = self->is_okay && is_okay;
+    pthread_cond_broadcast(&self->done);
+  } while ( true );
 
-  if ( !is_okay )
-    return is_okay;
+  pthread_mutex_unlock(&self->lock);
 
-  is_okay = ds_event_bin_pool_initialize(&self->bins, max_bins);
+  return NULL;
+}
 
-  if ( !is_okay ) {
-    ds_event_pool_deinitialize(&self->events);
-    return is_okay;
-  }
+static void ds_spill_wait (
+  struct ds_spill *             self
+)
+{
+  pthread_mutex_lock(&self->lock);
 
-  self->head  = (struct ds_event_bin *)NULL;
-  self->tail  = (struct ds_event_bin *)NULL;
+  while ( self->is_staging ) {
+    pthread_cond_wait(&self->done, &self->lock);
+  }
 
-  return true;
+  pthread_mutex_unlock(&self->lock);
 }
 
-void ds_event_queue_deinitialize (
-  struct ds_event_queue *       self
+static void ds_spill_request (
+  struct ds_spill *             self
 )
 {
-  assert(NULL != (void *)self);
-  assert(NULL == (void *)self->head);
-  assert(NULL == (void *)self->tail);
+  pthread_mutex_lock(&self->lock);
 
-  ds_event_bin_pool_deinitialize(&self->bins);
-  ds_event_pool_deinitialize(&self->events);
+  self->staging_horizon     = (unsigned long long)self->horizon + self->window;
+  self->num_staging_runs    = self->num_runs;
+  self->num_staging_records = self->num_records;
+  self->staged_index        = 0U;
+  self->is_staging          = true;
+  self->is_staged           = true;
+
+  pthread_cond_signal(&self->start);
+  pthread_mutex_unlock(&self->lock);
 }
 
-bool ds_event_queue_enqueue (
-  struct ds_event_queue *       self,
-  unsigned int                  time,
-  enum ds_event_type            type,
-  void *                        data
+static int ds_spill_open (
+  struct ds_spill *             self
 )
 {
-  assert(NULL != (void *)self);
-
-  struct ds_event * event = ds_event_pool_acquire(&self->events,
-    time,
-    type,
-    data
-  );
+  size_t length = strlen(self->directory) + sizeof("/ash-spill-XXXXXX");
+  char * path   = (char *)malloc(length);
 
-  if ( NULL == (void *)event )
-    return false;
+  if ( NULL == (void *)path ) {
+    ERROR("Cannot allocate the spill path: %s.", strerror(errno));
+    return -1;
+  }
 
-  struct ds_event_bin * curr  = self->head;
-  struct ds_event_bin * prev;
+  snprintf(path, length, "%s/ash-spill-XXXXXX", self->directory);
 
-  while ( NULL != (void *)curr ) {
-    if ( time <= curr->time )
-      break;
+  int fd  = mkstemp(path);
 
-    prev  = curr;
-    curr  = curr->next;
+  if ( 0 > fd ) {
+    ERROR("Cannot create spill file `%s`: %s.",
+      path,
+      strerror(errno)
+    );
+  } else {
+    /// anonymous from now on, released with the descriptor
+    unlink(path);
   }
 
-  if ( NULL == (void *)curr || time != curr->time ) {
-    /// no bin has been found, then acquire a new one
-    struct ds_event_bin * bin = ds_event_bin_pool_acquire(&self->bins, event);
-
-    if ( NULL == (void *)bin ) {
-      ds_event_pool_release(&self->events, event);
-      return false;
-    }
+  free(path);
+  return fd;
+}
 
-    if ( NULL != (void *)curr ) {
-      prev->next  = bin;
-      bin->next   = curr;
-      return true;
-    }
+static bool ds_spill_write (
+  int                           fd,
+  struct ds_spill_record const * records,
+  size_t                        num_records,
+  size_t                        offset
+)
+{
+  char const * bytes    = (char const *)records;
+  size_t       size     = num_records * sizeof(*records);
+  off_t        position = (off_t)( offset * sizeof(*records) );
 
-    /// append the bin
-    if ( NULL != (void *)self->tail ) {
-      self->tail->next  = bin;
-    }
+  while ( 0U < size ) {
+    ssize_t num_bytes = pwrite(fd, bytes, size, position);
 
-    self->tail  = bin;
+    if ( 0 > num_bytes ) {
+      if ( EINTR == errno )
+        continue;
 
-    if ( NULL == (void *)self->head ) {
-      self->head  = self->tail;
+      ERROR("Cannot write %zu spilled bytes: %s.",
+        size,
+        strerror(errno)
+      );
+      return false;
     }
 
-    return true;
+    bytes    += num_bytes;
+    size     -= (size_t)num_bytes;
+    position += num_bytes;
   }
 
-  ds_event_bin_insert(curr, event);
   return true;
 }
 
-struct ds_event * ds_event_queue_dequeue (
-  struct ds_event_queue *       self,
-  unsigned int                  time_limit
+static bool ds_spill_compact (
+  struct ds_spill *             self
 )
 {
-  assert(NULL != (void *)self);
+  /// merge every run into a single one, in a new file
+  ds_spill_wait(self);
 
-  struct ds_event_bin * bin = self->head;
+  unsigned long long  horizon   = self->staging_horizon;
+  size_t              num_staged = self->num_staged;
 
-  if ( NULL == (void *)bin || time_limit <= bin->time )
-    return (struct ds_event *)NULL;
+  self->num_staging_runs    = self->num_runs;
+  self->num_staging_records = self->num_records;
+  self->staging_horizon     = ULLONG_MAX;
 
-  struct ds_event * event = ds_event_bin_remove(bin);
-  /// if the bin is present, it cannot be empty
-  assert(NULL != (void *)event);
+  /// keep what has been staged already in front of the merged records
+  struct ds_spill_record * staging      = self->staging;
+  size_t                   max_staged   = self->max_staged;
 
-  if ( ds_event_bin_is_empty(bin) ) {
-    self->head  = bin->next;
+  self->staging     = (struct ds_spill_record *)NULL;
+  self->max_staged  = 0U;
 
-    if ( NULL == (void *)self->head ) {
-      self->tail  = self->head;
+  bool is_okay  = ds_spill_stage(self);
+
+  struct ds_spill_record * records      = self->staging;
+  size_t                   num_records  = self->num_staged;
+
+  self->staging         = staging;
+  self->num_staged      = num_staged;
+  self->max_staged      = max_staged;
+  self->staging_horizon = horizon;
+
+  if ( !is_okay ) {
+    free(records);
+    return false;
+  }
+
+  int fd  = ds_spill_open(self);
+
+  if ( 0 > fd || !ds_spill_write(fd, records, num_records, 0U) ) {
+    if ( 0 <= fd ) {
+      close(fd);
     }
 
-    bin->next = (struct ds_event_bin *)NULL;
-    ds_event_bin_pool_release(&self->bins, bin);
+    free(records);
+    return false;
   }
 
-  return event;
-}
+  free(records);
+  close(self->fd);
 
-void ds_event_queue_recycle (
-  struct ds_event_queue *       self,
-  struct ds_event *             event
-)
-{
-  assert(NULL != (void *)self);
-  assert(NULL != (void *)event);
+  self->fd                = fd;
+  self->num_records       = num_records;
+  self->num_runs          = 1U;
+  self->runs[ 0 ].offset      = 0U;
+  self->runs[ 0 ].num_records = num_records;
+  self->runs[ 0 ].index       = 0U;
+  self->num_staging_runs  = 0U;
 
-  ds_event_pool_release(&self->events, event);
+  return true;
 }
 
-bool ds_event_queue_is_empty (
-  struct ds_event_queue *       self
+static bool ds_spill_flush (
+  struct ds_spill *             self
 )
 {
-  assert(NULL != (void *)self);
+  if ( 0U == self->num_buffered )
+    return true;
 
-  return NULL == (void *)self->head;
-}
+  if ( self->num_runs == self->max_runs && !ds_spill_compact(self) )
+    return false;
 
-/// Simulator
+  qsort(self->buffer, self->num_buffered, sizeof(*self->buffer), ds_spill_record_compare);
 
-bool ds_simulator_initialize (
-  struct ds_simulator *         self,
-  unsigned int                  max_events,
-  unsigned int                  max_bins,
-  unsigned int                  time_step
+  if ( !ds_spill_write(self->fd, self->buffer, self->num_buffered, self->num_records) )
+    return false;
+
+  struct ds_spill_run * run = self->runs + self->num_runs;
+
+  run->offset       = self->num_records;
+  run->num_records  = self->num_buffered;
+  run->index        = 0U;
+
+  ++self->num_runs;
+  self->num_records  += self->num_buffered;
+  self->num_buffered  = 0U;
+
+  return true;
+}
+
+bool ds_spill_initialize (
+  struct ds_spill *             self,
+  char const *                  directory,
+  unsigned int                  window,
+  size_t                        max_buffered,
+  unsigned int                  max_runs
 )
 {
   assert(NULL != (void *)self);
 
-  if ( 0U == time_step ) {
+  if ( NULL == (void *)directory ) {
     ERROR("Invalid argument `%s`: %s.",
-      "time_step",
-      "Out of range [1;MAX_UINT]"
+      "directory",
+      "Unexpected null pointer"
     );
     return false;
   }
 
-  bool is_okay;
+  if ( 0U == window || 0U == max_buffered || 2U > max_runs ) {
+    ERROR("Invalid argument `%s`: %s.",
+      0U == window ? "window" : 0U == max_buffered ? "max_buffered" : "max_runs",
+      2U > max_runs && 0U != window && 0U != max_buffered
+        ? "Out of range [2;MAX_UINT]" : "Out of range [1;MAX_UINT]"
+    );
+    return false;
+  }
 
-  is_okay = ds_event_queue_initialize(&self->queue, max_events, max_bins);
+  self->directory = strdup(directory);
+  self->runs      = (struct ds_spill_run *)malloc(max_runs * sizeof(*self->runs));
+  self->buffer    = (struct ds_spill_record *)malloc(max_buffered * sizeof(*self->buffer));
+
+  if ( NULL == (void *)self->directory
+    || NULL == (void *)self->runs
+    || NULL == (void *)self->buffer ) {
+    ERROR("Cannot allocate the spill buffers: %s.", strerror(errno));
+    free(self->buffer);
+    free(self->runs);
+    free(self->directory);
+    return false;
+  }
 
-  if ( !is_okay )
-    return is_okay;
+  self->fd  = ds_spill_open(self);
 
-  self->time      = 0U;
-  self->time_step = time_step;
+  if ( 0 > self->fd ) {
+    free(self->buffer);
+    free(self->runs);
+    free(self->directory);
+    return false;
+  }
+
+  self->num_records         = 0U;
+  self->num_runs            = 0U;
+  self->max_runs            = max_runs;
+  self->num_buffered        = 0U;
+  self->max_buffered        = max_buffered;
+  self->staging             = (struct ds_spill_record *)NULL;
+  self->num_staged          = 0U;
+  self->max_staged          = 0U;
+  self->staged_index        = 0U;
+  self->horizon             = window;
+  self->window              = window;
+  self->staging_horizon     = 0ULL;
+  self->num_staging_runs    = 0U;
+  self->num_staging_records = 0U;
+  self->sequence            = 0ULL;
+  self->num_pending         = 0ULL;
+  self->is_staging          = false;
+  self->is_staged           = false;
+  self->is_stopping         = false;
+  self->is_okay             = true;
+
+  pthread_mutex_init(&self->lock, NULL);
+  pthread_cond_init(&self->start, NULL);
+  pthread_cond_init(&self->done, NULL);
+
+  int error = pthread_create(&self->thread, NULL, ds_spill_main, self);
+
+  if ( 0 != error ) {
+    ERROR("Cannot create the spill thread: %s.", strerror(error));
+    pthread_cond_destroy(&self->done);
+    pthread_cond_destroy(&self->start);
+    pthread_mutex_destroy(&self->lock);
+    close(self->fd);
+    free(self->buffer);
+    free(self->runs);
+    free(self->directory);
+    return false;
+  }
 
   return true;
 }
 
-void ds_simulator_deinitialize (
-  struct ds_simulator *         self
+void ds_spill_deinitialize (
+  struct ds_spill *             self
 )
 {
   assert(NULL != (void *)self);
-  assert(0U != self->time_step);
+  assert(NULL != (void *)self->runs);
 
-  ds_event_queue_deinitialize(&self->queue);
+  pthread_mutex_lock(&self->lock);
+  self->is_stopping = true;
+  pthread_cond_signal(&self->start);
+  pthread_mutex_unlock(&self->lock);
+
+  pthread_join(self->thread, NULL);
+
+  pthread_cond_destroy(&self->done);
+  pthread_cond_destroy(&self->start);
+  pthread_mutex_destroy(&self->lock);
+
+  close(self->fd);
+  free(self->staging);
+  free(self->buffer);
+  free(self->runs);
+  free(self->directory);
 }
 
-bool ds_simulator_schedule (
-  struct ds_simulator *         self,
+bool ds_spill_append (
+  struct ds_spill *             self,
   unsigned int                  time,
   enum ds_event_type            type,
   void *                        data
 )
 {
   assert(NULL != (void *)self);
+  assert(time >= self->horizon);
 
-  if ( time < self->time ) {
-    ERROR("Invalid argument `%s`: Scheduling time %u has to be >=%u.",
-      "time",
-      time,
-      self->time
+  if ( (int)DS_NUM_EVENT_TYPES <= (int)type ) {
+    ERROR("Invalid argument `%s`: %s.",
+      "type",
+      "Out of range [0;DS_NUM_EVENT_TYPES-1]"
     );
     return false;
   }
 
-  return ds_event_queue_enqueue(&self->queue,
-    time,
-    type,
-    data
-  );
+  if ( self->num_buffered == self->max_buffered && !ds_spill_flush(self) )
+    return false;
+
+  struct ds_spill_record * record = self->buffer + self->num_buffered++;
+
+  record->time      = (uint32_t)time;
+  record->type      = (uint32_t)type;
+  record->sequence  = self->sequence++;
+  record->data      = (uint64_t)(uintptr_t)data;
+
+  ++self->num_pending;
+  return true;
 }
 
-unsigned int ds_simulator_simulate (
-  struct ds_simulator *         self
+bool ds_spill_refill (
+  struct ds_spill *             self,
+  struct ds_event_queue *       queue,
+  unsigned int                  time_limit
 )
 {
   assert(NULL != (void *)self);
+  assert(NULL != (void *)queue);
 
-  unsigned int num_events = 0U;
-  unsigned int time_limit = self->time + self->time_step;
-
-  do {
-    struct ds_event * event = ds_event_queue_dequeue(&self->queue, time_limit);
+  while ( self->horizon < time_limit ) {
+    if ( 0ULL == self->num_pending ) {
+      /// nothing to merge back, then just move on
+      unsigned long long horizon = (unsigned long long)time_limit + self->window;
 
-    if ( NULL == (void *)event )
+      self->horizon   = horizon < UINT_MAX ? (unsigned int)horizon : UINT_MAX;
+      self->is_staged = false;
       break;
+    }
 
-    ds_event_process(event);
-    ++num_events;
+    if ( !self->is_staged ) {
+      ds_spill_flush(self);
+      ds_spill_request(self);
+    }
 
-    ds_event_queue_recycle(&self->queue, event);
-  } while ( true );
+    ds_spill_wait(self);
 
-  self->time += self->time_step;
+    if ( !self->is_okay || !ds_spill_flush(self) )
+      return false;
 
-  return num_events;
-}
+    /// catch up with the runs written since the staging was requested
+    unsigned int              num_runs  = self->num_runs - self->num_staging_runs;
+    struct ds_spill_record *  records   = 0U == num_runs
+      ? (struct ds_spill_record *)NULL : ds_spill_map(self, self->num_records);
+    struct ds_spill_cursor *  cursors
+      = (struct ds_spill_cursor *)malloc(( num_runs + 1U ) * sizeof(*cursors));
 
-bool ds_simulator_is_empty (
-  struct ds_simulator *         self
-)
-{
-  assert(NULL != (void *)self);
+    if ( NULL == (void *)cursors || ( 0U != num_runs && NULL == (void *)records ) ) {
+      ERROR("Cannot merge the spilled runs: %s.", strerror(errno));
+      free(cursors);
+
+      if ( NULL != (void *)records ) {
+        munmap(records, self->num_records * sizeof(*records));
+      }
+
+      return false;
+    }
+
+    /// the cursors persist: a refill failing midway resumes where it stopped
+    cursors[ 0 ].records      = self->staging;
+    cursors[ 0 ].num_records  = self->num_staged;
+    cursors[ 0 ].index        = &self->staged_index;
+
+    for ( unsigned int index = 0U; index < num_runs; ++index ) {
+      struct ds_spill_run * run = self->runs + self->num_staging_runs + index;
+
+      cursors[ index + 1U ].records     = records + run->offset;
+      cursors[ index + 1U ].num_records = run->num_records;
+      cursors[ index + 1U ].index       = &run->index;
+    }
+
+    /// records come sorted and after every pending event: they are appended,
+    /// each cursor moving past its record only once it has been enqueued
+    unsigned int num_heap = ds_spill_build(cursors, num_runs + 1U, self->staging_horizon);
+    bool         is_okay  = true;
+
+    while ( 0U < num_heap ) {
+      struct ds_spill_record const * record = cursors->records + *cursors->index;
+
+      is_okay = ds_event_queue_enqueue(queue,
+        (unsigned int)record->time,
+        (enum ds_event_type)record->type,
+        (void *)(uintptr_t)record->data
+      );
+
+      if ( !is_okay )
+        break;
+
+      --self->num_pending;
+      num_heap  = ds_spill_advance(cursors, num_heap, self->staging_horizon);
+    }
+
+    free(cursors);
+
+    if ( NULL != (void *)records ) {
+      munmap(records, self->num_records * sizeof(*records));
+    }
+
+    if ( !is_okay ) {
+      ERROR("Cannot merge back the spilled events before %llu: %llu are pending.",
+        self->staging_horizon,
+        self->num_pending
+      );
+      return false;
+    }
+
+    self->horizon      = self->staging_horizon < UINT_MAX
+      ? (unsigned int)self->staging_horizon : UINT_MAX;
+    self->is_staged    = false;
+
+    if ( 0ULL == self->num_pending ) {
+      /// every run has been consumed, then start over
+      if ( 0 != ftruncate(self->fd, 0) ) {
+        ALERT("Cannot truncate the spill file: %s.", strerror(errno));
+      } else {
+        self->num_records = 0U;
+        self->num_runs    = 0U;
+      }
+    } else {
+      /// stage the next window in the background
+      ds_spill_flush(self);
+      ds_spill_request(self);
+    }
+  }
 
-  return ds_event_queue_is_empty(&self->queue);
+  return true;
 }
 
-unsigned int ds_simulator_drain (
-  struct ds_simulator *         self
+unsigned long long ds_spill_clear (
+  struct ds_spill *             self
 )
 {
   assert(NULL != (void *)self);
 
-  unsigned int num_events = 0U;
+  ds_spill_wait(self);
 
-  do {
-    struct ds_event * event = ds_event_queue_dequeue(&self->queue, UINT_MAX);
+  unsigned long long num_pending  = self->num_pending;
 
-    if ( NULL == (void *)event )
-      break;
+  if ( 0 != ftruncate(self->fd, 0) ) {
+    ALERT("Cannot truncate the spill file: %s.", strerror(errno));
+  }
 
-    ++num_events;
+  self->num_records   = 0U;
+  self->num_runs      = 0U;
+  self->num_buffered  = 0U;
+  self->num_staged    = 0U;
+  self->staged_index  = 0U;
+  self->num_pending   = 0ULL;
+  self->is_staged     = false;
 
-    ds_event_queue_recycle(&self->queue, event);
-  } while ( true );
+  return num_pending;
+}
 
-  return num_events;
+bool ds_spill_is_empty (
+  struct ds_spill *             self
+)
+{
+  assert(NULL != (void *)self);
+
+  return 0ULL == self->num_pending;
 }
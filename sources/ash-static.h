@@ -0,0 +1,283 @@
+/// HEADERS
+
+# ifndef ASH_STATIC_H
+# define ASH_STATIC_H
+
+# include <stdbool.h>
+# include <stddef.h>
+# include <stdio.h>
+
+/// header-only variant of the simulator, specialized at compile time for one
+/// model: the event record, the time type and the handlers are fixed, the
+/// pools are sized statically and the dispatch is a `switch`, so that the
+/// handlers get inlined into the simulation loop
+///
+///   # define MM1_HANDLERS(X) X(MM1_ARRIVAL, mm1_arrive) X(MM1_DEPARTURE, mm1_depart)
+///
+///   DS_STATIC_DECLARE(mm1, struct mm1_customer, unsigned int, MM1_HANDLERS, 4096U, 1024U)
+///
+///   static inline void mm1_arrive (
+///     struct mm1_simulator *        simulator,
+///     unsigned int                  time,
+///     struct mm1_customer *         customer
+///   ) { ... mm1_schedule(simulator, time + 5U, MM1_DEPARTURE, *customer); ... }
+///
+///   DS_STATIC_DEFINE(mm1, MM1_HANDLERS)
+///
+/// events of a timestamp are dispatched in scheduling order, as by the
+/// library; the record is a copy, its event being recycled before the
+/// handler runs, so `max_events` only has to cover the pending events
+
+# define DS_STATIC_ERROR(format, ...)                                         \
+  fprintf(stderr, "[ERROR] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+
+# if defined(__GNUC__)
+#   define DS_STATIC_CTZ(word)  ( (size_t)__builtin_ctzll((word)) )
+# else
+static inline size_t DS_STATIC_CTZ (
+  unsigned long long            word
+)
+{
+  size_t count  = 0U;
+
+  for ( ; 0ULL == ( word & 1ULL ); word >>= 1U ) {
+    ++count;
+  }
+
+  return count;
+}
+# endif
+
+/// in the `handlers` list: X(<event type>, <handler>)
+# define DS_STATIC_ENUMERATOR(type, handler)  type,
+# define DS_STATIC_CASE(type, handler)                                        \
+  case type: handler(self, time, &record); break;
+
+/// types, name##_initialize(), _schedule() and _is_empty(), with one calendar
+/// bin per timestamp modulo `num_bins` (a power of two): events a multiple of
+/// `num_bins` apart share a bin, sorted by time, and a bitmap of the bins that
+/// are not empty lets the simulation jump over the others
+# define DS_STATIC_DECLARE(name, record_type, time_type, handlers, max_events, num_bins) \
+                                                                              \
+_Static_assert(0U < (max_events), "No events");                              \
+_Static_assert(0U < (num_bins) && 0U == ( (num_bins) & ( (num_bins) - 1U ) ),   \
+  "Number of bins is not a power of two");                                    \
+                                                                              \
+typedef time_type name##_time;                                                \
+typedef record_type name##_record;                                            \
+                                                                              \
+enum name##_event_type {                                                      \
+  handlers(DS_STATIC_ENUMERATOR)                                              \
+                                                                              \
+  name##_num_event_types                                                      \
+};                                                                            \
+                                                                              \
+enum {                                                                        \
+  name##_max_events = (max_events),                                           \
+  name##_num_bins   = (num_bins)                                              \
+};                                                                            \
+                                                                              \
+struct name##_event {                                                         \
+  struct name##_event *         next;                                         \
+  time_type                     time;                                         \
+  enum name##_event_type        type;                                         \
+  record_type                   record;                                       \
+};                                                                            \
+                                                                              \
+struct name##_simulator {                                                     \
+  time_type                     time;                                         \
+  time_type                     time_step;                                    \
+  size_t                        num_pending_events;                           \
+  struct name##_event *         free_event;                                   \
+  struct name##_event *         heads [ num_bins ];                           \
+  struct name##_event *         tails [ num_bins ];                           \
+  unsigned long long            occupied [ ( (num_bins) + 63U ) / 64U ];      \
+  struct name##_event           events [ max_events ];                        \
+};                                                                            \
+                                                                              \
+static inline bool name##_initialize (                                        \
+  struct name##_simulator *     self,                                         \
+  time_type                     time_step                                     \
+)                                                                             \
+{                                                                             \
+  if ( 0U == time_step ) {                                                    \
+    DS_STATIC_ERROR("Invalid argument `%s`: %s.",                             \
+      "time_step",                                                            \
+      "Out of range [1;MAX]"                                                  \
+    );                                                                        \
+    return false;                                                             \
+  }                                                                           \
+                                                                              \
+  self->time                = 0U;                                             \
+  self->time_step           = time_step;                                      \
+  self->num_pending_events  = 0U;                                             \
+  self->free_event          = (struct name##_event *)NULL;                    \
+                                                                              \
+  for ( size_t index = (max_events); 0U < index; --index ) {                  \
+    self->events[ index - 1U ].next = self->free_event;                       \
+    self->free_event                = self->events + index - 1U;              \
+  }                                                                           \
+                                                                              \
+  for ( size_t bin = 0U; bin < (num_bins); ++bin ) {                          \
+    self->heads[ bin ]  = (struct name##_event *)NULL;                        \
+    self->tails[ bin ]  = (struct name##_event *)NULL;                        \
+  }                                                                           \
+                                                                              \
+  for ( size_t word = 0U; word < ( (num_bins) + 63U ) / 64U; ++word ) {       \
+    self->occupied[ word ]  = 0ULL;                                           \
+  }                                                                           \
+                                                                              \
+  return true;                                                                \
+}                                                                             \
+                                                                              \
+static inline bool name##_schedule (                                          \
+  struct name##_simulator *     self,                                         \
+  time_type                     time,                                         \
+  enum name##_event_type        type,                                         \
+  record_type                   record                                        \
+)                                                                             \
+{                                                                             \
+  if ( time < self->time ) {                                                  \
+    DS_STATIC_ERROR("Invalid argument `%s`: Scheduling time %llu has to be >=%llu.", \
+      "time",                                                                 \
+      (unsigned long long)time,                                               \
+      (unsigned long long)self->time                                          \
+    );                                                                        \
+    return false;                                                             \
+  }                                                                           \
+                                                                              \
+  struct name##_event * event = self->free_event;                             \
+                                                                              \
+  if ( NULL == (void *)event ) {                                              \
+    DS_STATIC_ERROR("Out of memory: Maximum number of events (%u) has been reached.", \
+      (unsigned int)(max_events)                                              \
+    );                                                                        \
+    return false;                                                             \
+  }                                                                           \
+                                                                              \
+  self->free_event  = event->next;                                            \
+  event->time       = time;                                                   \
+  event->type       = type;                                                   \
+  event->record     = record;                                                 \
+                                                                              \
+  size_t                bin   = (size_t)( time & ( (num_bins) - 1U ) );       \
+  struct name##_event * tail  = self->tails[ bin ];                           \
+                                                                              \
+  ++self->num_pending_events;                                                 \
+                                                                              \
+  /* the common case: no later event shares the bin */                        \
+  if ( NULL == (void *)tail || tail->time <= time ) {                         \
+    event->next = (struct name##_event *)NULL;                                \
+                                                                              \
+    if ( NULL == (void *)tail ) {                                             \
+      self->heads[ bin ]              = event;                                \
+      self->occupied[ bin / 64U ]    |= 1ULL << ( bin % 64U );                \
+    } else {                                                                  \
+      tail->next          = event;                                            \
+    }                                                                         \
+                                                                              \
+    self->tails[ bin ]  = event;                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  struct name##_event **  link  = self->heads + bin;                          \
+                                                                              \
+  while ( (*link)->time <= time ) {                                           \
+    link  = &(*link)->next;                                                   \
+  }                                                                           \
+                                                                              \
+  event->next = *link;                                                        \
+  *link       = event;                                                        \
+                                                                              \
+  return true;                                                                \
+}                                                                             \
+                                                                              \
+static inline bool name##_is_empty (                                          \
+  struct name##_simulator *     self                                          \
+)                                                                             \
+{                                                                             \
+  return 0U == self->num_pending_events;                                      \
+}                                                                             \
+                                                                              \
+/* bins from `bin` to the next one that is not empty, `num_bins` if none */   \
+static inline size_t name##_distance (                                        \
+  struct name##_simulator *     self,                                         \
+  size_t                        bin                                           \
+)                                                                             \
+{                                                                             \
+  size_t distance = 1U;                                                       \
+                                                                              \
+  while ( distance < (num_bins) ) {                                           \
+    size_t              next  = ( bin + distance ) & ( (num_bins) - 1U );     \
+    unsigned long long  word  = self->occupied[ next / 64U ] >> ( next % 64U ); \
+                                                                              \
+    if ( 0ULL != word ) {                                                     \
+      distance += DS_STATIC_CTZ(word);                                        \
+      return distance < (num_bins) ? distance : (num_bins);                   \
+    }                                                                         \
+                                                                              \
+    /* to the next word, or to the first bin past the last one */             \
+    distance  += ( (num_bins) - next < 64U - next % 64U )                     \
+      ? (num_bins) - next : 64U - next % 64U;                                 \
+  }                                                                           \
+                                                                              \
+  return (num_bins);                                                          \
+}
+
+/// name##_simulate(), dispatching to the handlers of `handlers`, which have
+/// to be defined before
+# define DS_STATIC_DEFINE(name, handlers)                                     \
+                                                                              \
+static inline unsigned int name##_simulate (                                  \
+  struct name##_simulator *     self                                          \
+)                                                                             \
+{                                                                             \
+  unsigned int  num_events  = 0U;                                             \
+  name##_time   time_limit  = self->time + self->time_step;                   \
+                                                                              \
+  for ( name##_time time = self->time;                                        \
+        time != time_limit && 0U != self->num_pending_events; ) {             \
+    size_t                bin   = (size_t)( time & ( name##_num_bins - 1U ) ); \
+    struct name##_event * event;                                              \
+                                                                              \
+    /* bins already swept are not looked at again before they wrap */        \
+    self->time  = time;                                                       \
+                                                                              \
+    /* handlers may schedule at `time`, behind the event being processed */   \
+    while ( NULL != (void *)( event = self->heads[ bin ] ) && time == event->time ) { \
+      self->heads[ bin ]  = event->next;                                      \
+                                                                              \
+      if ( NULL == (void *)event->next ) {                                    \
+        self->tails[ bin ]              = (struct name##_event *)NULL;        \
+        self->occupied[ bin / 64U ]    &= ~( 1ULL << ( bin % 64U ) );         \
+      }                                                                       \
+                                                                              \
+      enum name##_event_type  type    = event->type;                          \
+      name##_record           record  = event->record;                        \
+                                                                              \
+      event->next       = self->free_event;                                   \
+      self->free_event  = event;                                              \
+      --self->num_pending_events;                                             \
+      ++num_events;                                                           \
+                                                                              \
+      switch ( type ) {                                                       \
+        handlers(DS_STATIC_CASE)                                              \
+                                                                              \
+        default:                                                              \
+          break;                                                              \
+      }                                                                       \
+    }                                                                         \
+                                                                              \
+    /* empty bins have nothing due: jump to the next occupied one */          \
+    name##_time distance  = (name##_time)name##_distance(self, bin);          \
+                                                                              \
+    time  = (name##_time)( time_limit - time ) <= distance                    \
+      ? time_limit : (name##_time)( time + distance );                        \
+  }                                                                           \
+                                                                              \
+  self->time  = time_limit;                                                   \
+                                                                              \
+  return num_events;                                                          \
+}
+
+# endif /* ASH_STATIC_H */
@@ -0,0 +1,306 @@
+/// HEADERS
+
+# define _GNU_SOURCE
+
+# include <stdbool.h>
+# include <stdlib.h>
+# include <stdio.h>
+# include <stdatomic.h>
+# include <stdint.h>
+
+/// layout of the shared-memory segment, duplicated from ash-demo.c: both
+/// sides check the magic and the version
+# define DS_TELEMETRY_MAGIC             0x54485341U
+# define DS_TELEMETRY_VERSION           1U
+# define DS_TELEMETRY_MAX_TYPES         32U
+# define DS_TELEMETRY_NAME_SIZE         16U
+
+struct ds_telemetry_segment {
+  _Atomic uint32_t              magic;
+  uint32_t                      version;
+  uint32_t                      pid;
+  uint32_t                      num_types;
+  _Atomic uint64_t              sequence;
+  _Atomic uint64_t              time;
+  _Atomic uint64_t              time_step;
+  _Atomic uint64_t              num_steps;
+  _Atomic uint64_t              num_events;
+  _Atomic uint64_t              events_per_second;
+  _Atomic uint64_t              num_pending_events;
+  _Atomic uint64_t              num_bins;
+  _Atomic uint64_t              max_events;
+  _Atomic uint64_t              max_bins;
+  _Atomic uint64_t              num_type_events [ DS_TELEMETRY_MAX_TYPES ];
+  char                          type_names [ DS_TELEMETRY_MAX_TYPES ][ DS_TELEMETRY_NAME_SIZE ];
+};
+
+/// consistent copy of the published values
+struct ds_telemetry_snapshot {
+  uint64_t                      time;
+  uint64_t                      time_step;
+  uint64_t                      num_steps;
+  uint64_t                      num_events;
+  uint64_t                      events_per_second;
+  uint64_t                      num_pending_events;
+  uint64_t                      num_bins;
+  uint64_t                      max_events;
+  uint64_t                      max_bins;
+  uint64_t                      num_type_events [ DS_TELEMETRY_MAX_TYPES ];
+};
+
+static struct ds_telemetry_segment * ds_telemetry_attach (
+  char const *                  name
+);
+
+/// attempts at a consistent copy before giving up: a publisher stopped in
+/// the middle of a write would otherwise hang the reader
+# define DS_TELEMETRY_MAX_RETRIES       4096U
+
+/// false if no consistent copy could be made, `snapshot` being left as is
+static bool ds_telemetry_read (
+  struct ds_telemetry_segment * segment,
+  struct ds_telemetry_snapshot * snapshot
+);
+
+static void ds_telemetry_render (
+  char const *                  name,
+  struct ds_telemetry_segment * segment,
+  struct ds_telemetry_snapshot * snapshot,
+  bool                          is_stale
+);
+
+/// MAIN
+
+# include <errno.h>
+# include <signal.h>
+# include <string.h>
+# include <time.h>
+# include <unistd.h>
+# include <sys/stat.h>
+
+int main ( int argc, char const * const * argv )
+{
+  if ( 2 > argc || 3 < argc ) {
+    fprintf(stderr, "Usage: %s <pid|/name> [interval_ms]\n", argv[ 0 ]);
+    return EXIT_FAILURE;
+  }
+
+  /// a bare pid names the default segment of that process
+  char name [ 64 ];
+
+  if ( '/' == argv[ 1 ][ 0 ] ) {
+    snprintf(name, sizeof(name), "%s", argv[ 1 ]);
+  } else {
+    snprintf(name, sizeof(name), "/ash-%s", argv[ 1 ]);
+  }
+
+  long interval = 3 == argc ? strtol(argv[ 2 ], NULL, 10) : 1000L;
+
+  if ( 0L >= interval ) {
+    fprintf(stderr, "Invalid interval `%s`.\n", argv[ 2 ]);
+    return EXIT_FAILURE;
+  }
+
+  struct ds_telemetry_segment * segment = ds_telemetry_attach(name);
+
+  if ( NULL == (void *)segment )
+    return EXIT_FAILURE;
+
+  struct ds_telemetry_snapshot snapshot  = { 0U };
+  struct timespec              delay = {
+    .tv_sec   = (time_t)( interval / 1000L ),
+    .tv_nsec  = ( interval % 1000L ) * 1000000L
+  };
+
+  do {
+    bool is_stale = !ds_telemetry_read(segment, &snapshot);
+
+    ds_telemetry_render(name, segment, &snapshot, is_stale);
+
+    nanosleep(&delay, NULL);
+
+    /// a publisher that died leaves its segment behind
+    if ( 0 != kill((pid_t)segment->pid, 0) && ESRCH == errno ) {
+      printf("Process %u is gone.\n", segment->pid);
+      break;
+    }
+
+    /// the publisher unlinks the segment when done
+    struct stat status;
+    char        path [ 80 ];
+
+    snprintf(path, sizeof(path), "/dev/shm%s", name);
+
+    if ( 0 != stat(path, &status) ) {
+      printf("Segment `%s` is gone.\n", name);
+      break;
+    }
+  } while ( true );
+
+  return EXIT_SUCCESS;
+}
+
+/// SOURCES
+
+# include <fcntl.h>
+# include <sys/mman.h>
+
+# define ERROR(format, ...)     fprintf(stderr, "[ERROR] %s:%d: " format "\n", __FILE__, __LINE__, __VA_ARGS__)
+
+# if defined(__x86_64__) || defined(__i386__)
+#   define CPU_RELAX()          __builtin_ia32_pause()
+# elif defined(__aarch64__)
+#   define CPU_RELAX()          __asm__ __volatile__ ( "yield" )
+# else
+#   define CPU_RELAX()          do { } while ( false )
+# endif
+
+/// Telemetry
+
+static struct ds_telemetry_segment * ds_telemetry_attach (
+  char const *                  name
+)
+{
+  int fd  = shm_open(name, O_RDONLY, 0);
+
+  if ( 0 > fd ) {
+    ERROR("Cannot open shared memory `%s`: %s.",
+      name,
+      strerror(errno)
+    );
+    return (struct ds_telemetry_segment *)NULL;
+  }
+
+  struct stat status;
+
+  if ( 0 != fstat(fd, &status) || sizeof(struct ds_telemetry_segment) > (size_t)status.st_size ) {
+    ERROR("Invalid shared memory `%s`: %s.",
+      name,
+      "Too small"
+    );
+    close(fd);
+    return (struct ds_telemetry_segment *)NULL;
+  }
+
+  void * memory = mmap(NULL,
+    sizeof(struct ds_telemetry_segment),
+    PROT_READ,
+    MAP_SHARED,
+    fd,
+    0
+  );
+
+  close(fd);
+
+  if ( MAP_FAILED == memory ) {
+    ERROR("Cannot map shared memory `%s`: %s.",
+      name,
+      strerror(errno)
+    );
+    return (struct ds_telemetry_segment *)NULL;
+  }
+
+  struct ds_telemetry_segment * segment = (struct ds_telemetry_segment *)memory;
+
+  if ( DS_TELEMETRY_MAGIC != atomic_load_explicit(&segment->magic, memory_order_acquire)
+    || DS_TELEMETRY_VERSION != segment->version
+    || DS_TELEMETRY_MAX_TYPES < segment->num_types ) {
+    ERROR("Invalid shared memory `%s`: %s.",
+      name,
+      "Unknown layout"
+    );
+    munmap(memory, sizeof(struct ds_telemetry_segment));
+    return (struct ds_telemetry_segment *)NULL;
+  }
+
+  return segment;
+}
+
+static bool ds_telemetry_read (
+  struct ds_telemetry_segment * segment,
+  struct ds_telemetry_snapshot * snapshot
+)
+{
+  struct ds_telemetry_snapshot copy = *snapshot;
+
+  for ( unsigned int retry = 0U; retry < DS_TELEMETRY_MAX_RETRIES; ++retry ) {
+    uint64_t sequence = atomic_load_explicit(&segment->sequence, memory_order_acquire);
+
+    if ( 0U != ( sequence & 1U ) ) {
+      CPU_RELAX();
+      continue;
+    }
+
+    copy.time                = atomic_load_explicit(&segment->time, memory_order_relaxed);
+    copy.time_step           = atomic_load_explicit(&segment->time_step, memory_order_relaxed);
+    copy.num_steps           = atomic_load_explicit(&segment->num_steps, memory_order_relaxed);
+    copy.num_events          = atomic_load_explicit(&segment->num_events, memory_order_relaxed);
+    copy.events_per_second   = atomic_load_explicit(&segment->events_per_second, memory_order_relaxed);
+    copy.num_pending_events  = atomic_load_explicit(&segment->num_pending_events, memory_order_relaxed);
+    copy.num_bins            = atomic_load_explicit(&segment->num_bins, memory_order_relaxed);
+    copy.max_events          = atomic_load_explicit(&segment->max_events, memory_order_relaxed);
+    copy.max_bins            = atomic_load_explicit(&segment->max_bins, memory_order_relaxed);
+
+    for ( uint32_t type = 0U; type < segment->num_types; ++type ) {
+      copy.num_type_events[ type ] = atomic_load_explicit(segment->num_type_events + type,
+        memory_order_relaxed
+      );
+    }
+
+    atomic_thread_fence(memory_order_acquire);
+
+    if ( sequence == atomic_load_explicit(&segment->sequence, memory_order_relaxed) ) {
+      *snapshot = copy;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void ds_telemetry_render (
+  char const *                  name,
+  struct ds_telemetry_segment * segment,
+  struct ds_telemetry_snapshot * snapshot,
+  bool                          is_stale
+)
+{
+  double event_usage  = 0U == snapshot->max_events ? 0.0
+    : 100.0 * (double)snapshot->num_pending_events / (double)snapshot->max_events;
+  double bin_usage    = 0U == snapshot->max_bins ? 0.0
+    : 100.0 * (double)snapshot->num_bins / (double)snapshot->max_bins;
+
+  /// home the cursor and clear the screen
+  printf("\033[H\033[2J");
+  printf("ash-top: %s (pid %u)%s\n\n", name, segment->pid, is_stale ? " stale" : "");
+  printf("%-12s %20llu (dt=%llu, %llu steps)\n", "time",
+    (unsigned long long)snapshot->time,
+    (unsigned long long)snapshot->time_step,
+    (unsigned long long)snapshot->num_steps
+  );
+  printf("%-12s %20llu (%llu/s)\n", "processed",
+    (unsigned long long)snapshot->num_events,
+    (unsigned long long)snapshot->events_per_second
+  );
+  printf("%-12s %20llu / %llu (%.1f%%)\n", "pending",
+    (unsigned long long)snapshot->num_pending_events,
+    (unsigned long long)snapshot->max_events,
+    event_usage
+  );
+  printf("%-12s %20llu / %llu (%.1f%%)\n\n", "bins",
+    (unsigned long long)snapshot->num_bins,
+    (unsigned long long)snapshot->max_bins,
+    bin_usage
+  );
+  printf("%-16s %16s\n", "type", "processed");
+
+  for ( uint32_t type = 0U; type < segment->num_types; ++type ) {
+    printf("%-16.*s %16llu\n",
+      (int)DS_TELEMETRY_NAME_SIZE,
+      segment->type_names[ type ],
+      (unsigned long long)snapshot->num_type_events[ type ]
+    );
+  }
+
+  fflush(stdout);
+}